@@ -0,0 +1,102 @@
+#include "header.h"
+#include <cstring>
+#include <fcntl.h>
+
+// Block device counters from /proc/diskstats. Lines look like
+// " 254  0 vda 8737 5019 1349330 6336 3182 2486 1579528 3478 0 2588 10173 ..."
+// Sectors are always 512 bytes here, whatever the device's real sector size.
+#define DISKSTATS_SECTOR_BYTES 512
+
+enum DiskKind { DISK_WHOLE, DISK_PARTITION, DISK_LAYER };
+
+// Partitions have a "partition" attribute; devices without a "device" link are
+// software layers (device-mapper, md, loop, zram). Devices come and go rarely,
+// so each name is looked up in sysfs only the first time it is seen.
+static DiskKind diskKind(const char* name) {
+    static std::map<std::string, DiskKind> kinds;
+    auto it = kinds.find(name);
+    if (it != kinds.end()) return it->second;
+
+    std::string dir = std::string("/sys/class/block/") + name;
+    DiskKind kind = DISK_WHOLE;
+    if (access((dir + "/partition").c_str(), F_OK) == 0) {
+        kind = DISK_PARTITION;
+    } else if (access((dir + "/device").c_str(), F_OK) != 0) {
+        kind = DISK_LAYER;
+    }
+    kinds[name] = kind;
+    return kind;
+}
+
+bool readDiskStats(std::vector<DiskStats>& disks, bool physical_only) {
+    disks.clear();
+
+    int fd = open("/proc/diskstats", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    std::string content;
+    char buffer[16384];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        content.append(buffer, n);
+    }
+    close(fd);
+    if (content.empty()) return false;
+
+    for (size_t start = 0; start < content.size(); ) {
+        size_t end = content.find('\n', start);
+        if (end == std::string::npos) end = content.size();
+        const char* line = content.c_str() + start;
+        start = end + 1;
+
+        // Classify by name first so hidden devices cost no number parsing
+        char name[64];
+        int name_end = 0;
+        if (sscanf(line, "%*u %*u %63s%n", name, &name_end) != 1) continue;
+        DiskKind kind = diskKind(name);
+        if (physical_only && kind != DISK_WHOLE) continue;
+
+        DiskStats disk;
+        if (sscanf(line + name_end, "%lu %lu %lu %lu %lu %lu %lu %lu %lu %lu %lu", &disk.reads, &disk.reads_merged,
+                   &disk.sectors_read, &disk.read_ms, &disk.writes, &disk.writes_merged, &disk.sectors_written,
+                   &disk.write_ms, &disk.in_flight, &disk.io_ms, &disk.weighted_io_ms) != 11) continue;
+
+        // Never-used devices (spare loop devices) are just noise
+        if (physical_only && disk.reads == 0 && disk.writes == 0) continue;
+
+        disk.name = name;
+        disk.partition = kind == DISK_PARTITION;
+        disk.layer = kind == DISK_LAYER;
+        disks.push_back(disk);
+    }
+    return true;
+}
+
+DiskRates diskRatesBetween(const DiskStats& prev, const DiskStats& curr, float seconds) {
+    DiskRates rates;
+    rates.in_flight = curr.in_flight;
+    if (seconds <= 0.0f) return rates;
+
+    // Counters going backwards mean the device was replaced; report no activity
+    auto delta = [](unsigned long before, unsigned long after) { return after >= before ? after - before : 0UL; };
+    unsigned long reads = delta(prev.reads, curr.reads);
+    unsigned long writes = delta(prev.writes, curr.writes);
+    unsigned long read_ms = delta(prev.read_ms, curr.read_ms);
+    unsigned long write_ms = delta(prev.write_ms, curr.write_ms);
+
+    rates.read_iops = reads / seconds;
+    rates.write_iops = writes / seconds;
+    rates.read_bytes = (float)delta(prev.sectors_read, curr.sectors_read) * DISKSTATS_SECTOR_BYTES / seconds;
+    rates.write_bytes = (float)delta(prev.sectors_written, curr.sectors_written) * DISKSTATS_SECTOR_BYTES / seconds;
+
+    // Time with I/O in flight over wall time is utilisation; the in-flight
+    // weighted time over wall time is the average queue depth
+    float wall_ms = seconds * 1000.0f;
+    rates.utilization = std::min(100.0f, 100.0f * delta(prev.io_ms, curr.io_ms) / wall_ms);
+    rates.queue_depth = delta(prev.weighted_io_ms, curr.weighted_io_ms) / wall_ms;
+
+    rates.read_await_ms = reads > 0 ? (float)read_ms / reads : 0.0f;
+    rates.write_await_ms = writes > 0 ? (float)write_ms / writes : 0.0f;
+    rates.await_ms = reads + writes > 0 ? (float)(read_ms + write_ms) / (reads + writes) : 0.0f;
+    return rates;
+}
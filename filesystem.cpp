@@ -0,0 +1,327 @@
+#include "header.h"
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <condition_variable>
+#include <deque>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+// Filesystem usage for every real mount. The mount list is re-read only when
+// poll() on /proc/self/mountinfo reports a change. statvfs() runs on a small pool
+// of persistent probe workers fed by a queue: a probe that does not finish within
+// the timeout (a hung NFS server) marks its mount stale, and that mount gets no
+// new probe until the old one returns. A stuck probe pins one worker, and the
+// pool grows by one for each, so one bad mount never delays the others or the caller.
+#define FILESYSTEM_PROBE_TIMEOUT_MS 1500
+#define FILESYSTEM_PROBE_WORKERS 4
+#define FILESYSTEM_PROBE_MAX_WORKERS 32
+
+// Kernel-internal and virtual filesystems that have no meaningful usage
+static const char* pseudo_filesystems[] = {
+    "proc", "sysfs", "devtmpfs", "devpts", "tmpfs", "ramfs", "cgroup", "cgroup2", "pstore", "bpf",
+    "debugfs", "tracefs", "securityfs", "configfs", "fusectl", "mqueue", "hugetlbfs", "autofs",
+    "binfmt_misc", "rpc_pipefs", "nsfs", "efivarfs", "selinuxfs", "squashfs", "nfsd",
+};
+
+// One statvfs() call in flight. Shared with its (detached) thread so a probe
+// that never returns cannot outlive the state it writes to.
+struct FilesystemProbe {
+    std::string path;
+    std::mutex mutex;
+    std::condition_variable done_signal;
+    bool done = false;
+    bool ok = false;
+    struct statvfs result;
+    std::chrono::steady_clock::time_point started;
+};
+
+struct TrackedMount {
+    MountInfo info;
+    std::shared_ptr<FilesystemProbe> probe;
+    unsigned long prev_used_kb = 0;
+    std::chrono::steady_clock::time_point prev_sample;
+};
+
+// Probes waiting for a worker. Shared with the (detached) workers, which may be
+// stuck in statvfs() when the monitor stops.
+struct ProbeQueue {
+    std::mutex mutex;
+    std::condition_variable work_signal;
+    std::deque<std::shared_ptr<FilesystemProbe>> pending;
+    int workers = 0;
+    int idle = 0;
+    bool stopping = false;
+};
+
+static std::shared_ptr<ProbeQueue> probe_queue;
+static std::mutex filesystem_mutex;
+static std::vector<MountInfo> filesystem_list; // published copy
+static std::atomic<bool> filesystem_running(false);
+static std::thread filesystem_thread;
+static int filesystem_stop_fd = -1;
+
+// Mountinfo escapes space, tab, newline and backslash as \ooo
+static std::string unescapeMountField(const std::string& field) {
+    std::string out;
+    for (size_t i = 0; i < field.size(); i++) {
+        if (field[i] == '\\' && i + 3 < field.size() &&isdigit((unsigned char)field[i + 1])) {
+            out += (char)strtol(field.substr(i + 1, 3).c_str(), nullptr, 8);
+            i += 3;
+        } else {
+            out += field[i];
+        }
+    }
+    return out;
+}
+
+// "36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - ext3 /dev/root rw,errors=continue"
+static std::vector<MountInfo> readMountinfo(int fd) {
+    std::vector<MountInfo> mounts;
+    std::string content;
+    char buffer[4096];
+    ssize_t n;
+    lseek(fd, 0, SEEK_SET);
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        content.append(buffer, n);
+    }
+
+    std::vector<std::string> seen_devices;
+    std::istringstream lines(content);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream iss(line);
+        std::string mount_id, parent_id, device_number, root, mount_point, options, field;
+        if (!(iss >> mount_id >> parent_id >> device_number >> root >> mount_point >> options)) continue;
+
+        // Skip optional fields up to the separator
+        while (iss >> field && field != "-") {}
+        std::string fs_type, source;
+        if (!(iss >> fs_type >> source)) continue;
+
+        bool pseudo = false;
+        for (const char* name : pseudo_filesystems) {
+            if (fs_type == name) {
+                pseudo = true;
+                break;
+            }
+        }
+        if (pseudo) continue;
+
+        // Bind mounts share a device; report each filesystem once
+        if (std::find(seen_devices.begin(), seen_devices.end(), device_number) != seen_devices.end()) continue;
+        seen_devices.push_back(device_number);
+
+        MountInfo mount;
+        mount.mount_point = unescapeMountField(mount_point);
+        mount.device = unescapeMountField(source);
+        mount.fs_type = fs_type;
+        mounts.push_back(mount);
+    }
+    return mounts;
+}
+
+static void probeWorker(std::shared_ptr<ProbeQueue> queue) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    for (;;) {
+        queue->idle++;
+        queue->work_signal.wait(lock, [&] { return queue->stopping || !queue->pending.empty(); });
+        queue->idle--;
+        if (queue->stopping) break;
+        std::shared_ptr<FilesystemProbe> probe = queue->pending.front();
+        queue->pending.pop_front();
+        lock.unlock();
+
+        struct statvfs result;
+        bool ok = statvfs(probe->path.c_str(), &result) == 0;
+        {
+            std::lock_guard<std::mutex> probe_lock(probe->mutex);
+            probe->result = result;
+            probe->ok = ok;
+            probe->done = true;
+            probe->done_signal.notify_all();
+        }
+        lock.lock();
+    }
+    queue->workers--;
+}
+
+// Queues a probe, adding a worker when none is free and the pool is below max_workers
+static void startProbe(TrackedMount& mount, int max_workers) {
+    std::shared_ptr<FilesystemProbe> probe = std::make_shared<FilesystemProbe>();
+    probe->path = mount.info.mount_point;
+    probe->started = std::chrono::steady_clock::now();
+    mount.probe = probe;
+
+    std::lock_guard<std::mutex> lock(probe_queue->mutex);
+    probe_queue->pending.push_back(probe);
+    if ((int)probe_queue->pending.size() > probe_queue->idle && probe_queue->workers < max_workers) {
+        probe_queue->workers++;
+        std::thread(probeWorker, probe_queue).detach();
+    }
+    probe_queue->work_signal.notify_one();
+}
+
+static void applyProbe(TrackedMount& mount, const FilesystemProbe& probe) {
+    MountInfo& info = mount.info;
+    info.stale = false;
+    if (!probe.ok) return;
+
+    const struct statvfs& stat = probe.result;
+    unsigned long long block = stat.f_frsize ? stat.f_frsize : stat.f_bsize;
+    info.total_kb = (unsigned long)(stat.f_blocks * block / 1024);
+    info.free_kb = (unsigned long)(stat.f_bavail * block / 1024);
+    unsigned long unused_kb = (unsigned long)(stat.f_bfree * block / 1024);
+    info.used_kb = info.total_kb > unused_kb ? info.total_kb - unused_kb : 0;
+    info.inodes_total = stat.f_files;
+    info.inodes_free = stat.f_ffree;
+
+    // Growth of used space between good samples
+    auto now = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(now - mount.prev_sample).count();
+    if (info.has_usage && seconds > 0.0f) {
+        info.growth_kb_per_second = ((float)info.used_kb - (float)mount.prev_used_kb) / seconds;
+    }
+    mount.prev_used_kb = info.used_kb;
+    mount.prev_sample = now;
+    info.has_usage = true;
+}
+
+static void probeMounts(std::vector<TrackedMount>& mounts) {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<TrackedMount*> ready;
+    int stuck = 0;
+    for (TrackedMount& mount : mounts) {
+        // A previous probe still stuck in the kernel: leave the mount stale
+        if (mount.probe) {
+            std::lock_guard<std::mutex> lock(mount.probe->mutex);
+            if (!mount.probe->done) {
+                if (now - mount.probe->started >= std::chrono::milliseconds(FILESYSTEM_PROBE_TIMEOUT_MS)) {
+                    mount.info.stale = true;
+                }
+                stuck++;
+                continue;
+            }
+        }
+        ready.push_back(&mount);
+    }
+    // Each stuck probe holds a worker; the others still get the base pool
+    int max_workers = std::min(FILESYSTEM_PROBE_MAX_WORKERS, FILESYSTEM_PROBE_WORKERS + stuck);
+    for (TrackedMount* mount : ready) startProbe(*mount, max_workers);
+
+    // Collect results, giving every probe the same deadline
+    auto deadline = now + std::chrono::milliseconds(FILESYSTEM_PROBE_TIMEOUT_MS);
+    for (TrackedMount& mount : mounts) {
+        if (!mount.probe) continue;
+        std::unique_lock<std::mutex> lock(mount.probe->mutex);
+        if (mount.probe->started < now) continue; // stuck from an earlier round
+        if (mount.probe->done_signal.wait_until(lock, deadline, [&] { return mount.probe->done; })) {
+            applyProbe(mount, *mount.probe);
+        } else {
+            mount.info.stale = true;
+        }
+    }
+}
+
+static void filesystemLoop(float interval_seconds) {
+    int mountinfo_fd = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+    if (mountinfo_fd < 0) return;
+
+    std::vector<TrackedMount> mounts;
+    bool mounts_changed = true;
+    while (filesystem_running) {
+        if (mounts_changed) {
+            // Keep state (probes, growth) for mounts that are still there
+            std::vector<TrackedMount> updated;
+            for (const MountInfo& info : readMountinfo(mountinfo_fd)) {
+                auto it = std::find_if(mounts.begin(), mounts.end(), [&](const TrackedMount& m) {
+                    return m.info.mount_point == info.mount_point;
+                });
+                if (it != mounts.end()) {
+                    TrackedMount mount = *it;
+                    // Something else mounted at the same point: its usage and growth start over
+                    if (mount.info.device != info.device || mount.info.fs_type != info.fs_type) {
+                        mount.info = info;
+                        mount.prev_used_kb = 0;
+                    }
+                    updated.push_back(mount);
+                } else {
+                    TrackedMount mount;
+                    mount.info = info;
+                    updated.push_back(mount);
+                }
+            }
+            mounts.swap(updated);
+            mounts_changed = false;
+        }
+
+        probeMounts(mounts);
+        {
+            std::lock_guard<std::mutex> lock(filesystem_mutex);
+            filesystem_list.clear();
+            for (const TrackedMount& mount : mounts) filesystem_list.push_back(mount.info);
+        }
+        requestRedraw();
+
+        // The mount table signals changes with POLLPRI
+        pollfd fds[2] = {{mountinfo_fd, POLLPRI, 0}, {filesystem_stop_fd, POLLIN, 0}};
+        if (poll(fds, 2, (int)(interval_seconds * 1000.0f)) > 0) {
+            if (fds[1].revents) break;
+            if (fds[0].revents & (POLLPRI | POLLERR)) mounts_changed = true;
+        }
+    }
+    close(mountinfo_fd);
+}
+
+bool startFilesystemMonitor(float interval_seconds) {
+    if (filesystem_running) return false;
+
+    filesystem_stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (filesystem_stop_fd < 0) return false;
+
+    probe_queue = std::make_shared<ProbeQueue>();
+    filesystem_running = true;
+    filesystem_thread = std::thread(filesystemLoop, interval_seconds);
+    return true;
+}
+
+void stopFilesystemMonitor() {
+    if (!filesystem_running) return;
+
+    filesystem_running = false;
+    uint64_t one = 1;
+    if (write(filesystem_stop_fd, &one, sizeof(one)) < 0) {
+        // The stop counter is already set
+    }
+    if (filesystem_thread.joinable()) filesystem_thread.join();
+    close(filesystem_stop_fd);
+    filesystem_stop_fd = -1;
+
+    // Idle workers exit now; one stuck in statvfs() exits when it returns
+    {
+        std::lock_guard<std::mutex> lock(probe_queue->mutex);
+        probe_queue->stopping = true;
+        probe_queue->pending.clear();
+    }
+    probe_queue->work_signal.notify_all();
+    probe_queue.reset();
+}
+
+void getFilesystems(std::vector<MountInfo>& filesystems) {
+    std::lock_guard<std::mutex> lock(filesystem_mutex);
+    filesystems = filesystem_list;
+}
+
+bool getFilesystem(const std::string& mount_point, MountInfo& filesystem) {
+    std::lock_guard<std::mutex> lock(filesystem_mutex);
+    for (const MountInfo& mount : filesystem_list) {
+        if (mount.mount_point == mount_point) {
+            filesystem = mount;
+            return true;
+        }
+    }
+    return false;
+}
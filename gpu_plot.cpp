@@ -0,0 +1,289 @@
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "header.h"
+#include "imgui_internal.h"
+#include <deque>
+
+// GPU-resident plots: every history ring gets a persistent vertex buffer holding
+// one float per slot (slot = absolute sample index % capacity). Each frame only the
+// samples appended since the last frame are uploaded with glBufferSubData, and the
+// line strip is drawn from an ImDrawList callback, so per-frame CPU cost does not
+// depend on how much history is on screen.
+//
+// The buffer has one extra slot mirroring slot 0, so a window that wraps around the
+// end of the ring can be drawn as two strips that still meet.
+//
+// Series are keyed by the ring's address. One that goes undrawn for
+// GPU_SERIES_IDLE_FRAMES frames is deleted, so rings that went away (a removed
+// disk, a closed remote host) do not keep their buffers, and a ring that later
+// reuses the address starts from an empty series.
+#define GPU_SERIES_IDLE_FRAMES 600
+
+struct GpuSeries {
+    GLuint buffer = 0;
+    GLuint vao = 0;
+    size_t capacity = 0;
+    unsigned long long uploaded = 0; // absolute index of the next sample to upload
+    float last_value = 0.0f;         // sample uploaded - 1, to notice a different ring
+    int drawn_frame = 0;
+};
+
+struct GpuPlotDraw {
+    const GpuSeries* series;
+    ImRect rect;
+    float scale_min, scale_max;
+    int begin_slot;
+    int count;
+    ImVec4 color;
+};
+
+static std::map<const HistoryRing*, GpuSeries> gpu_series;
+static std::deque<GpuPlotDraw> gpu_draws; // stable addresses for callback data
+static int gpu_draws_frame = -1;
+static std::vector<float> gpu_staging;
+
+static GLuint gpu_program = 0;
+static bool gpu_program_failed = false; // fall back to plotHistory() for good
+static GLint gpu_rect_location, gpu_display_location, gpu_scale_location;
+static GLint gpu_begin_slot_location, gpu_capacity_location, gpu_last_position_location, gpu_color_location;
+
+static const char* gpu_vertex_shader =
+    "#version 130\n"
+    "in float value;\n"
+    "uniform vec4 rect;\n"
+    "uniform vec4 display;\n"
+    "uniform vec2 scale;\n"
+    "uniform int begin_slot;\n"
+    "uniform int capacity;\n"
+    "uniform float last_position;\n"
+    "void main() {\n"
+    "    int position = gl_VertexID - begin_slot;\n"
+    "    if (position < 0) position += capacity;\n"
+    "    float t = last_position > 0.0 ? float(position) / last_position : 0.0;\n"
+    "    float v = scale.y != scale.x ? clamp((value - scale.x) / (scale.y - scale.x), 0.0, 1.0) : 0.0;\n"
+    "    vec2 pixel = vec2(mix(rect.x, rect.z, t), mix(rect.w, rect.y, v));\n"
+    "    vec2 ndc = (pixel - display.xy) / display.zw * 2.0 - 1.0;\n"
+    "    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);\n"
+    "}\n";
+
+static const char* gpu_fragment_shader =
+    "#version 130\n"
+    "uniform vec4 color;\n"
+    "out vec4 out_color;\n"
+    "void main() {\n"
+    "    out_color = color;\n"
+    "}\n";
+
+static GLuint compileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint status = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        char log[512];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        fprintf(stderr, "GPU plot shader failed to compile: %s\n", log);
+    }
+    return shader;
+}
+
+static bool createGpuProgram() {
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, gpu_vertex_shader);
+    GLuint fragment = compileShader(GL_FRAGMENT_SHADER, gpu_fragment_shader);
+    gpu_program = glCreateProgram();
+    glAttachShader(gpu_program, vertex);
+    glAttachShader(gpu_program, fragment);
+    glBindAttribLocation(gpu_program, 0, "value");
+    glLinkProgram(gpu_program);
+    glDetachShader(gpu_program, vertex);
+    glDetachShader(gpu_program, fragment);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint status = 0;
+    glGetProgramiv(gpu_program, GL_LINK_STATUS, &status);
+    if (!status) {
+        glDeleteProgram(gpu_program);
+        gpu_program = 0;
+        gpu_program_failed = true;
+        return false;
+    }
+
+    gpu_rect_location = glGetUniformLocation(gpu_program, "rect");
+    gpu_display_location = glGetUniformLocation(gpu_program, "display");
+    gpu_scale_location = glGetUniformLocation(gpu_program, "scale");
+    gpu_begin_slot_location = glGetUniformLocation(gpu_program, "begin_slot");
+    gpu_capacity_location = glGetUniformLocation(gpu_program, "capacity");
+    gpu_last_position_location = glGetUniformLocation(gpu_program, "last_position");
+    gpu_color_location = glGetUniformLocation(gpu_program, "color");
+    return true;
+}
+
+static void writeSlots(GpuSeries& series, size_t slot, const float* values, size_t count) {
+    glBufferSubData(GL_ARRAY_BUFFER, slot * sizeof(float), count * sizeof(float), values);
+    if (slot == 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, series.capacity * sizeof(float), sizeof(float), values);
+    }
+}
+
+static void deleteSeries(GpuSeries& series) {
+    glDeleteBuffers(1, &series.buffer);
+    glDeleteVertexArrays(1, &series.vao);
+}
+
+// Once per frame, before the first plot
+static void evictIdleSeries(int frame) {
+    for (auto it = gpu_series.begin(); it != gpu_series.end(); ) {
+        if (frame - it->second.drawn_frame <= GPU_SERIES_IDLE_FRAMES) {
+            ++it;
+            continue;
+        }
+        deleteSeries(it->second);
+        it = gpu_series.erase(it);
+    }
+}
+
+// Brings the GPU copy of a ring up to date; called while the history lock is held
+static GpuSeries& syncGpuSeries(const HistoryRing& history) {
+    GpuSeries& series = gpu_series[&history];
+    series.drawn_frame = ImGui::GetFrameCount();
+    // Another ring at the same address: upload it all again
+    if (series.uploaded > history.total ||
+        (series.uploaded > historyOldest(history) && historyAt(history, series.uploaded - 1) != series.last_value)) {
+        series.uploaded = 0;
+    }
+    if (series.capacity != history.values.size()) {
+        if (!series.buffer) {
+            glGenBuffers(1, &series.buffer);
+            glGenVertexArrays(1, &series.vao);
+        }
+        series.capacity = history.values.size();
+        series.uploaded = 0;
+
+        glBindVertexArray(series.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, series.buffer);
+        glBufferData(GL_ARRAY_BUFFER, (series.capacity + 1) * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)0);
+        glBindVertexArray(0);
+    }
+    if (series.capacity == 0) return series;
+
+    unsigned long long from = std::max(series.uploaded, historyOldest(history));
+    if (from >= history.total) return series;
+
+    // Upload in runs that are contiguous in slot space
+    glBindBuffer(GL_ARRAY_BUFFER, series.buffer);
+    while (from < history.total) {
+        size_t slot = (size_t)(from % series.capacity);
+        size_t run = (size_t)std::min<unsigned long long>(history.total - from, series.capacity - slot);
+        gpu_staging.resize(run);
+        for (size_t i = 0; i < run; i++) {
+            gpu_staging[i] = historyAt(history, from + i);
+        }
+        writeSlots(series, slot, gpu_staging.data(), run);
+        from += run;
+    }
+    series.uploaded = history.total;
+    series.last_value = historyAt(history, history.total - 1);
+    return series;
+}
+
+static void drawGpuPlot(const ImDrawList*, const ImDrawCmd* cmd) {
+    const GpuPlotDraw& draw = *(const GpuPlotDraw*)cmd->UserCallbackData;
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+    ImVec2 scale = draw_data->FramebufferScale;
+    int fb_height = (int)(draw_data->DisplaySize.y * scale.y);
+
+    ImVec4 clip = cmd->ClipRect;
+    glScissor((int)((clip.x - draw_data->DisplayPos.x) * scale.x), (int)(fb_height - (clip.w - draw_data->DisplayPos.y) * scale.y),
+              (int)((clip.z - clip.x) * scale.x), (int)((clip.w - clip.y) * scale.y));
+
+    glUseProgram(gpu_program);
+    glUniform4f(gpu_rect_location, draw.rect.Min.x, draw.rect.Min.y, draw.rect.Max.x, draw.rect.Max.y);
+    glUniform4f(gpu_display_location, draw_data->DisplayPos.x, draw_data->DisplayPos.y,
+                draw_data->DisplaySize.x, draw_data->DisplaySize.y);
+    glUniform2f(gpu_scale_location, draw.scale_min, draw.scale_max);
+    glUniform1i(gpu_begin_slot_location, draw.begin_slot);
+    glUniform1i(gpu_capacity_location, (int)draw.series->capacity);
+    glUniform1f(gpu_last_position_location, (float)(draw.count - 1));
+    glUniform4f(gpu_color_location, draw.color.x, draw.color.y, draw.color.z, draw.color.w);
+    glBindVertexArray(draw.series->vao);
+
+    int capacity = (int)draw.series->capacity;
+    if (draw.begin_slot + draw.count <= capacity) {
+        glDrawArrays(GL_LINE_STRIP, draw.begin_slot, draw.count);
+    } else {
+        // Through the mirror slot, then on from slot 0
+        int head = capacity - draw.begin_slot;
+        glDrawArrays(GL_LINE_STRIP, draw.begin_slot, head + 1);
+        glDrawArrays(GL_LINE_STRIP, 0, draw.count - head);
+    }
+}
+
+void plotHistoryGpu(const char* id, const HistoryRing& history, unsigned long long begin, unsigned long long end,
+                    float scale_min, float scale_max, ImVec2 size, const char* overlay_text) {
+    if (gpu_program_failed || (!gpu_program && !createGpuProgram())) {
+        plotHistory(id, history, begin, end, scale_min, scale_max, size, overlay_text);
+        return;
+    }
+
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) return;
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    size = ImGui::CalcItemSize(size, ImGui::CalcItemWidth(), ImGui::GetFrameHeight());
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + size);
+    const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
+    ImGui::ItemSize(frame_bb, style.FramePadding.y);
+    if (!ImGui::ItemAdd(frame_bb, window->GetID(id))) return;
+
+    ImGui::RenderFrame(frame_bb.Min, frame_bb.Max, ImGui::GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+    if (gpu_draws_frame != ImGui::GetFrameCount()) {
+        gpu_draws.clear();
+        gpu_draws_frame = ImGui::GetFrameCount();
+        evictIdleSeries(gpu_draws_frame);
+    }
+
+    GpuSeries& series = syncGpuSeries(history);
+    begin = std::max(begin, historyOldest(history));
+    unsigned long long count = end > begin ? end - begin : 0;
+
+    if (count >= 2) {
+
+        GpuPlotDraw draw;
+        draw.series = &series;
+        draw.rect = inner_bb;
+        draw.scale_min = scale_min;
+        draw.scale_max = scale_max;
+        draw.begin_slot = (int)(begin % series.capacity);
+        draw.count = (int)count;
+        draw.color = ImGui::GetStyleColorVec4(ImGuiCol_PlotLines);
+        gpu_draws.push_back(draw);
+
+        window->DrawList->AddCallback(drawGpuPlot, &gpu_draws.back());
+        window->DrawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+
+        if (ImGui::IsItemHovered() && inner_bb.Contains(ImGui::GetIO().MousePos)) {
+            float t = (ImGui::GetIO().MousePos.x - inner_bb.Min.x) / inner_bb.GetWidth();
+            unsigned long long index = begin + std::min(count - 1, (unsigned long long)(t * count));
+            ImGui::SetTooltip("%llu: %8.4g", index, historyAt(history, index));
+        }
+    }
+
+    if (overlay_text) {
+        ImGui::RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max,
+                                 overlay_text, nullptr, nullptr, ImVec2(0.5f, 0.0f));
+    }
+}
+
+void shutdownGpuPlots() {
+    for (auto& entry : gpu_series) deleteSeries(entry.second);
+    gpu_series.clear();
+    gpu_draws.clear();
+
+    if (gpu_program) glDeleteProgram(gpu_program);
+    gpu_program = 0;
+}
@@ -0,0 +1,73 @@
+#include "header.h"
+
+// GL_TIME_ELAPSED queries around the ImGui render pass. Queries rotate through a
+// small ring and are read back a few frames late, so measuring never stalls the
+// pipeline waiting for the current frame.
+#define GPU_TIMER_QUERIES 4
+
+static GLuint gpu_timer_queries[GPU_TIMER_QUERIES];
+static bool gpu_timer_pending[GPU_TIMER_QUERIES];
+static int gpu_timer_next = 0;
+static bool gpu_timer_active = false; // a query is open for the current frame
+static bool gpu_timer_ready = false;
+static float gpu_timer_ms = 0.0f;
+
+bool initGpuTimer() {
+    // Timer queries are core in GL 3.3
+    if (gpu_timer_ready || !gl3wIsSupported(3, 3)) return gpu_timer_ready;
+
+    glGenQueries(GPU_TIMER_QUERIES, gpu_timer_queries);
+    for (int i = 0; i < GPU_TIMER_QUERIES; i++) gpu_timer_pending[i] = false;
+    gpu_timer_ready = true;
+    return true;
+}
+
+static void collectGpuTimer() {
+    for (int i = 0; i < GPU_TIMER_QUERIES; i++) {
+        if (!gpu_timer_pending[i]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(gpu_timer_queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(gpu_timer_queries[i], GL_QUERY_RESULT, &elapsed_ns);
+        gpu_timer_pending[i] = false;
+
+        // Smooth over a handful of frames so the overlay is readable
+        float ms = elapsed_ns / 1e6f;
+        gpu_timer_ms = gpu_timer_ms > 0.0f ? gpu_timer_ms * 0.9f + ms * 0.1f : ms;
+    }
+}
+
+void beginGpuTimer() {
+    if (!gpu_timer_ready) return;
+
+    collectGpuTimer();
+
+    // Every query still in flight: skip this frame rather than wait
+    if (gpu_timer_pending[gpu_timer_next]) return;
+
+    glBeginQuery(GL_TIME_ELAPSED, gpu_timer_queries[gpu_timer_next]);
+    gpu_timer_active = true;
+}
+
+void endGpuTimer() {
+    if (!gpu_timer_active) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    gpu_timer_pending[gpu_timer_next] = true;
+    gpu_timer_next = (gpu_timer_next + 1) % GPU_TIMER_QUERIES;
+    gpu_timer_active = false;
+}
+
+float gpuFrameMilliseconds() {
+    return gpu_timer_ms;
+}
+
+void shutdownGpuTimer() {
+    if (!gpu_timer_ready) return;
+
+    glDeleteQueries(GPU_TIMER_QUERIES, gpu_timer_queries);
+    gpu_timer_ready = false;
+}
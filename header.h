@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <numeric>
 #include <iomanip>
+#include <functional>
 #include <unistd.h>
 #include <sys/sysinfo.h>
 #include <sys/statvfs.h>
@@ -44,18 +45,90 @@ struct ProcessInfo {
     float cpu_usage;
     float memory_usage;
     unsigned long memory_kb;
+    unsigned long long start_time = 0; // clock ticks after boot, tells reused PIDs apart
+    unsigned long long cpu_ticks = 0; // user and system time so far, in clock ticks
+    int processor = -1; // CPU it last ran on
+
+    // From /proc/PID/io, readable only for our own processes unless privileged
+    bool io_known = false;
+    unsigned long long io_read_bytes = 0; // fetched from storage
+    unsigned long long io_write_bytes = 0; // sent to storage
+    unsigned long long io_cancelled_write_bytes = 0; // written then truncated before writeback
+    unsigned long long io_syscr = 0;
+    unsigned long long io_syscw = 0;
+    float io_read_rate = 0.0f; // bytes per second
+    float io_write_rate = 0.0f; // net of cancelled writes
+    float io_syscall_rate = 0.0f; // read and write calls per second
 };
 
+// Values are in kB unless noted
 struct MemoryInfo {
     unsigned long total_ram;
-    unsigned long used_ram;
-    unsigned long free_ram;
+    unsigned long used_ram; // total - available
+    unsigned long free_ram; // MemFree: not used for anything, not even cache
+    unsigned long available_ram; // MemAvailable: can be allocated without swapping
     unsigned long total_swap;
     unsigned long used_swap;
     unsigned long free_swap;
     unsigned long total_disk;
     unsigned long used_disk;
     unsigned long free_disk;
+
+    // Breakdown from /proc/meminfo
+    unsigned long buffers;
+    unsigned long cached; // page cache, includes shmem
+    unsigned long shmem; // tmpfs and shared memory, not reclaimable
+    unsigned long slab;
+    unsigned long slab_reclaimable;
+    unsigned long anon_pages;
+    unsigned long mapped;
+    unsigned long dirty;
+    unsigned long writeback;
+    unsigned long commit_limit;
+    unsigned long committed_as;
+    unsigned long hugepages_total; // pages
+    unsigned long hugepages_free; // pages
+    unsigned long hugepages_reserved; // pages
+    unsigned long hugepages_surplus; // pages
+    unsigned long hugepage_size;
+};
+
+// Cumulative counters from /proc/vmstat
+struct VmStatInfo {
+    unsigned long pgfault = 0;
+    unsigned long pgmajfault = 0;
+    unsigned long pswpin = 0; // pages swapped in
+    unsigned long pswpout = 0;
+    unsigned long pgscan_kswapd = 0; // pages scanned by background reclaim
+    unsigned long pgscan_direct = 0; // pages scanned by allocating tasks
+    unsigned long pgsteal_kswapd = 0; // pages reclaimed
+    unsigned long pgsteal_direct = 0;
+    unsigned long allocstall = 0; // allocations that entered direct reclaim
+    unsigned long compact_stall = 0;
+    unsigned long thp_fault_alloc = 0;
+    unsigned long thp_fault_fallback = 0;
+    unsigned long thp_collapse_alloc = 0;
+    unsigned long thp_split_page = 0;
+    unsigned long oom_kill = 0;
+};
+
+// The same counters as events per second
+struct VmStatRates {
+    float pgfault = 0.0f;
+    float pgmajfault = 0.0f;
+    float pswpin = 0.0f;
+    float pswpout = 0.0f;
+    float pgscan_kswapd = 0.0f;
+    float pgscan_direct = 0.0f;
+    float pgsteal_kswapd = 0.0f;
+    float pgsteal_direct = 0.0f;
+    float allocstall = 0.0f;
+    float compact_stall = 0.0f;
+    float thp_fault_alloc = 0.0f;
+    float thp_fault_fallback = 0.0f;
+    float thp_collapse_alloc = 0.0f;
+    float thp_split_page = 0.0f;
+    float oom_kill = 0.0f;
 };
 
 struct NetworkInterface {
@@ -63,56 +136,486 @@ struct NetworkInterface {
     unsigned long rx_bytes, rx_packets, rx_errs, rx_drop, rx_fifo, rx_frame, rx_compressed, rx_multicast;
     unsigned long tx_bytes, tx_packets, tx_errs, tx_drop, tx_fifo, tx_colls, tx_carrier, tx_compressed;
     std::string ipv4_address;
+    std::string ipv6_address; // empty when none
+    std::string group; // "physical", "bond", "bridge", "veth netns 3", ...
+    int link_speed_mbps = 0; // 0 when unknown: virtual or down
+    int ifindex = 0; // 0 when unknown; a new index under the same name is a new interface
+
+    // Per second since the previous sample, filled by updateInterfaceRates()
+    float rx_bytes_rate = 0.0f, tx_bytes_rate = 0.0f;
+    float rx_packets_rate = 0.0f, tx_packets_rate = 0.0f;
+    float rx_errs_rate = 0.0f, tx_errs_rate = 0.0f;
+    float rx_drop_rate = 0.0f, tx_drop_rate = 0.0f;
+};
+
+// Totals for one interface group, summed by the collector
+struct InterfaceGroupStats {
+    std::string name;
+    int interfaces = 0;
+    float rx_bytes_rate = 0.0f, tx_bytes_rate = 0.0f;
+    float rx_packets_rate = 0.0f, tx_packets_rate = 0.0f;
+    float errs_rate = 0.0f; // receive and transmit
+    float drop_rate = 0.0f;
+};
+
+// Cumulative protocol counters from /proc/net/snmp and /proc/net/netstat, and
+// socket gauges from /proc/net/sockstat
+struct ProtocolStats {
+    unsigned long long tcp_active_opens = 0; // connect() calls that sent a SYN
+    unsigned long long tcp_passive_opens = 0; // connections accepted
+    unsigned long long tcp_attempt_fails = 0;
+    unsigned long long tcp_estab_resets = 0;
+    unsigned long long tcp_curr_estab = 0; // gauge
+    unsigned long long tcp_in_segs = 0;
+    unsigned long long tcp_out_segs = 0;
+    unsigned long long tcp_retrans_segs = 0;
+    unsigned long long tcp_in_errs = 0;
+    unsigned long long tcp_out_rsts = 0;
+    unsigned long long tcp_in_csum_errors = 0;
+    unsigned long long udp_in_datagrams = 0;
+    unsigned long long udp_no_ports = 0; // datagrams to a port nobody listens on
+    unsigned long long udp_in_errors = 0;
+    unsigned long long udp_out_datagrams = 0;
+    unsigned long long udp_rcvbuf_errors = 0; // dropped because the receive buffer was full
+    unsigned long long udp_sndbuf_errors = 0;
+    unsigned long long listen_overflows = 0; // accept queue full
+    unsigned long long listen_drops = 0; // every SYN or ACK dropped by a listener
+    unsigned long long syncookies_sent = 0;
+    unsigned long long tcp_timeouts = 0; // retransmission timer expiries
+    unsigned long long tcp_syn_retrans = 0;
+    unsigned long long tcp_fast_retrans = 0;
+    unsigned long long tcp_lost_retransmit = 0;
+    unsigned long long tcp_abort_on_timeout = 0;
+    unsigned long long tcp_abort_on_memory = 0;
+    unsigned long long tcp_backlog_drop = 0;
+    unsigned long tcp_in_use = 0;
+    unsigned long tcp_orphans = 0;
+    unsigned long tcp_time_wait = 0;
+    unsigned long tcp_mem_pages = 0;
+    unsigned long udp_in_use = 0;
+    unsigned long udp_mem_pages = 0;
+};
+
+// The counters of ProtocolStats as events per second
+struct ProtocolRates {
+    float tcp_active_opens = 0.0f;
+    float tcp_passive_opens = 0.0f;
+    float tcp_attempt_fails = 0.0f;
+    float tcp_estab_resets = 0.0f;
+    float tcp_in_segs = 0.0f;
+    float tcp_out_segs = 0.0f;
+    float tcp_retrans_segs = 0.0f;
+    float tcp_in_errs = 0.0f;
+    float tcp_out_rsts = 0.0f;
+    float tcp_in_csum_errors = 0.0f;
+    float udp_in_datagrams = 0.0f;
+    float udp_no_ports = 0.0f;
+    float udp_in_errors = 0.0f;
+    float udp_out_datagrams = 0.0f;
+    float udp_rcvbuf_errors = 0.0f;
+    float udp_sndbuf_errors = 0.0f;
+    float listen_overflows = 0.0f;
+    float listen_drops = 0.0f;
+    float syncookies_sent = 0.0f;
+    float tcp_timeouts = 0.0f;
+    float tcp_syn_retrans = 0.0f;
+    float tcp_fast_retrans = 0.0f;
+    float tcp_lost_retransmit = 0.0f;
+    float tcp_abort_on_timeout = 0.0f;
+    float tcp_abort_on_memory = 0.0f;
+    float tcp_backlog_drop = 0.0f;
+    float retransmit_percent = 0.0f; // retransmitted share of segments sent
+};
+
+// One socket from NETLINK_SOCK_DIAG. Addresses are raw (4 or 16 bytes) and only
+// formatted for the rows on screen.
+struct SocketInfo {
+    unsigned char family = 0; // AF_INET, AF_INET6 or AF_UNIX
+    unsigned char protocol = 0; // IPPROTO_TCP or IPPROTO_UDP; 0 for Unix
+    unsigned char state = 0; // TCP_* numbering, used by UDP and Unix too
+    unsigned char unix_type = 0; // SOCK_STREAM, SOCK_DGRAM or SOCK_SEQPACKET
+    unsigned char local_address[16] = {};
+    unsigned char remote_address[16] = {};
+    unsigned short local_port = 0;
+    unsigned short remote_port = 0;
+    std::string unix_path; // '@' marks an abstract name
+    unsigned int rx_queue = 0; // listeners: connections waiting for accept()
+    unsigned int tx_queue = 0; // listeners: the accept backlog limit
+    unsigned int uid = 0;
+    unsigned long long inode = 0; // 0 for TIME_WAIT and orphans
+    unsigned long long cookie = 0; // identifies the socket across dumps
+    int pid = -1; // owning process, -1 when unknown
+    std::string process;
+
+    // From tcp_info, TCP only
+    bool has_tcp_info = false;
+    float rtt_ms = 0.0f;
+    float rtt_var_ms = 0.0f;
+    unsigned int cwnd = 0; // segments
+    unsigned int retransmits = 0; // over the connection's lifetime
+    unsigned long long bytes_acked = 0;
+    unsigned long long bytes_received = 0;
+};
+
+// Socket counts; TCP by state, indexed by TCP_* state number
+#define SOCKET_TCP_STATES 13
+struct SocketSummary {
+    int tcp_states[SOCKET_TCP_STATES] = {};
+    int udp_sockets = 0;
+    int unix_sockets = 0;
+    int unowned = 0; // have an inode but no process we can see
+};
+
+// Network throughput of one process, from the byte counters of its TCP sockets
+struct ProcessNetwork {
+    int pid = -1; // -1 gathers sockets without a visible owner
+    std::string name;
+    std::string cgroup;
+    int sockets = 0;
+    float rx_rate = 0.0f; // bytes per second
+    float tx_rate = 0.0f;
+};
+
+// The same, summed over the processes of one cgroup
+struct CgroupNetwork {
+    std::string cgroup;
+    int processes = 0;
+    float rx_rate = 0.0f;
+    float tx_rate = 0.0f;
 };
 
 struct CPUInfo {
     float usage_percent;
-    std::deque<float> usage_history;
     long user, nice, system, idle, iowait, irq, softirq;
 };
 
+// The headline temperature: a CPU sensor if there is one, else the hottest
 struct ThermalInfo {
     float temperature;
-    std::deque<float> temp_history;
+    bool available; // false when no temperature sensor exists
+    float critical; // °C, 0 when the sensor has no limit
+    std::string source; // chip and label
 };
 
+// The fastest fan
 struct FanInfo {
     bool active;
     int speed;
-    int level;
-    std::deque<float> speed_history;
+    int level; // PWM duty cycle in percent, -1 when unknown
+    bool available; // false when no fan sensor exists
+    std::string source;
+};
+
+// One RAPL domain from /sys/class/powercap
+struct PowerDomain {
+    std::string zone; // "intel-rapl:0", "intel-rapl:0:1"
+    std::string name; // "package-0", "core", "uncore", "dram", "psys"
+    bool top_level = false; // a package or psys rather than a part of one
+    bool readable = false; // energy_uj is often root-only
+    unsigned long long energy_uj = 0;
+    unsigned long long max_energy_uj = 0; // energy_uj wraps to zero here
+    float watts = 0.0f; // since the previous sample, filled by updatePowerRates()
+};
+
+// Estimated power of one process from its share of busy CPU time
+struct ProcessEnergy {
+    int pid = 0;
+    std::string name;
+    float cpu_share_percent = 0.0f; // of the busy CPU time of its package in the interval
+    float watts = 0.0f;
+    double joules = 0.0; // since we started watching it
+};
+
+enum SensorKind { SENSOR_TEMPERATURE, SENSOR_FAN, SENSOR_VOLTAGE, SENSOR_POWER, SENSOR_CURRENT };
+
+// One thermal zone or hwmon channel in display units: °C, RPM, V, W or A
+struct SensorReading {
+    SensorKind kind = SENSOR_TEMPERATURE;
+    std::string chip; // hwmon name or thermal zone type: "coretemp", "nvme", "acpitz"
+    std::string device; // sysfs directory, "hwmon3" or "thermal_zone0"; tells apart chips of the same name
+    std::string label; // "Package id 0", "fan1", "thermal_zone0"
+    float value = 0.0f;
+    bool valid = false; // the last read succeeded
+    float critical = 0.0f; // upper limit, 0 when none
+    float minimum = 0.0f; // lower limit (fans, voltages), 0 when none
+    int duty_percent = -1; // fans with a PWM control
+};
+
+// One NUMA node; memory in kB, numastat counters in pages
+struct NumaNode {
+    int id = 0;
+    std::vector<int> cpus;
+    CPUInfo cpu = {}; // summed over the node's CPUs, usage_percent since the last update
+    unsigned long total_ram = 0;
+    unsigned long free_ram = 0;
+    unsigned long used_ram = 0;
+    unsigned long file_pages = 0;
+    unsigned long anon_pages = 0;
+    unsigned long numa_hit = 0;
+    unsigned long numa_miss = 0; // allocated here though another node was preferred
+    unsigned long numa_foreign = 0; // meant for here but allocated elsewhere
+    unsigned long local_node = 0;
+    unsigned long other_node = 0; // allocated here for a task running on another node
+    float numa_miss_rate = 0.0f; // pages per second
+    float other_node_rate = 0.0f;
+    std::chrono::steady_clock::time_point sampled_at;
+};
+
+// Where a process's memory lives, from /proc/PID/numa_maps
+struct ProcessNuma {
+    bool available = false;
+    std::map<int, unsigned long> node_kb; // node id -> kB resident there
+    int home_node = -1; // node of the CPU it last ran on
+    float remote_percent = 0.0f; // share of its memory not on the home node
+    std::chrono::steady_clock::time_point sampled_at;
+};
+
+// Usage of one mounted filesystem; sizes in kB
+struct MountInfo {
+    std::string mount_point;
+    std::string device;
+    std::string fs_type;
+    unsigned long total_kb = 0;
+    unsigned long used_kb = 0;
+    unsigned long free_kb = 0; // available to unprivileged users
+    unsigned long long inodes_total = 0;
+    unsigned long long inodes_free = 0;
+    float growth_kb_per_second = 0.0f; // change in used space
+    bool has_usage = false; // statvfs has succeeded at least once
+    bool stale = false; // the last statvfs did not return in time
+};
+
+// Cumulative counters for one block device from /proc/diskstats; times in ms
+struct DiskStats {
+    std::string name;
+    bool partition = false;
+    bool layer = false; // device-mapper, md, loop and other software devices
+    unsigned long reads = 0;
+    unsigned long reads_merged = 0;
+    unsigned long sectors_read = 0;
+    unsigned long read_ms = 0;
+    unsigned long writes = 0;
+    unsigned long writes_merged = 0;
+    unsigned long sectors_written = 0;
+    unsigned long write_ms = 0;
+    unsigned long in_flight = 0; // current, not cumulative
+    unsigned long io_ms = 0; // time with at least one request in flight
+    unsigned long weighted_io_ms = 0; // in-flight requests times time
+};
+
+// Per-second activity of a block device between two DiskStats samples
+struct DiskRates {
+    float read_iops = 0.0f;
+    float write_iops = 0.0f;
+    float read_bytes = 0.0f;
+    float write_bytes = 0.0f;
+    float utilization = 0.0f; // percent of time busy
+    float queue_depth = 0.0f; // average requests in flight
+    float await_ms = 0.0f; // average time per request, queueing included
+    float read_await_ms = 0.0f;
+    float write_await_ms = 0.0f;
+    unsigned long in_flight = 0;
+};
+
+// Fixed-capacity history of samples, oldest overwritten first
+struct HistoryRing {
+    std::vector<float> values;
+    size_t head = 0;                // slot the next sample goes to
+    unsigned long long total = 0;   // samples ever pushed
+    unsigned long long dropped = 0; // samples discarded by a capacity change
+};
+
+// Latest sample served by the metrics exporter
+struct MetricsSnapshot {
+    SystemInfo system;
+    CPUInfo cpu = {};
+    MemoryInfo memory = {};
+    VmStatInfo vmstat;
+    std::vector<MountInfo> filesystems;
+    std::vector<SensorReading> sensors; // local only, not streamed
+    std::vector<NetworkInterface> interfaces;
+    ThermalInfo thermal = {};
+    FanInfo fan = {};
+    std::vector<ProcessInfo> top_processes;
+    long long timestamp_ms = 0;
+};
+
+// Shared sampler feeding the exporter, the streaming agent and shared memory
+struct SamplerSettings {
+    float interval_seconds = 1.0f;
+    int top_processes = 10;
+};
+
+typedef std::function<void(const MetricsSnapshot&)> SnapshotListener;
+
+// Metrics exporter settings
+struct MetricsSettings {
+    std::string address = "127.0.0.1";
+    int port = 0; // 0 disables the exporter
+};
+
+// Streaming agent settings
+struct StreamSettings {
+    std::string listen; // "host:port" or "unix:/path"
+};
+
+// A host watched by the multi-host viewer; its history is a short fixed window
+#define REMOTE_HISTORY_POINTS 600
+
+struct RemoteHost {
+    std::string address;
+    bool connected = false;
+    std::string status;
+    bool has_snapshot = false;
+    MetricsSnapshot snapshot;
+    std::vector<InterfaceGroupStats> interface_groups;
+    HistoryRing cpu_history;
+    HistoryRing thermal_history;
+    HistoryRing fan_history;
+    unsigned long frames_received = 0;
+    unsigned long bytes_received = 0;
+};
+
+// Facts about the host that do not change while we run, read once
+struct HostFacts {
+    unsigned long total_ram = 0; // kB
+    long page_size = 4096;
+    long clock_ticks = 100; // USER_HZ, the unit of /proc CPU times
+    int cpu_count = 1;
+};
+
+// What the current sampling tick has already collected. Collectors take
+// earlier results from here instead of reading them again.
+struct SampleContext {
+    const HostFacts* facts = nullptr;
+    const MemoryInfo* memory = nullptr; // this tick's meminfo, if read
+    const std::vector<ProcessInfo>* processes = nullptr; // every process, if scanned
 };
 
 // Graph settings
 struct GraphSettings {
-    bool animate = true;
-    float fps = 30.0f;
+    bool animate = true; // when off the view is frozen, sampling continues
+    float sample_rate = 2.0f; // samples per second, independent of the frame rate
     float y_scale = 100.0f;
-    int max_points = 200;
+    int max_points = 200; // samples in view; older ones stay in the ring
+    int task_id = -1; // scheduler task that samples this graph
+    unsigned long long frozen_at = 0; // history position shown while not animating
 };
 
 // Function declarations
 // System functions
-SystemInfo getSystemInfo();
-std::vector<ProcessInfo> getProcesses();
+const HostFacts& getHostFacts();
+SampleContext makeSampleContext();
+SystemInfo getSystemInfo(const SampleContext& context);
+std::vector<ProcessInfo> getProcesses(const SampleContext& context);
 MemoryInfo getMemoryInfo();
+void updateProcessIo(std::vector<ProcessInfo>& processes);
+bool readVmStat(VmStatInfo& info);
+bool updateNumaNodes(std::vector<NumaNode>& nodes);
+void requestProcessNuma(const std::vector<int>& pids);
+bool getProcessNuma(int pid, ProcessNuma& result);
+void stopProcessNuma();
+VmStatRates vmStatRatesBetween(const VmStatInfo& prev, const VmStatInfo& curr, float seconds);
+bool readDiskStats(std::vector<DiskStats>& disks, bool physical_only);
+DiskRates diskRatesBetween(const DiskStats& prev, const DiskStats& curr, float seconds);
+bool startFilesystemMonitor(float interval_seconds);
+void stopFilesystemMonitor();
+void getFilesystems(std::vector<MountInfo>& filesystems);
+bool getFilesystem(const std::string& mount_point, MountInfo& filesystem);
 std::vector<NetworkInterface> getNetworkInfo();
+std::vector<NetworkInterface> getNetworkInfoFromProc();
+bool readNetlinkInterfaces(std::vector<NetworkInterface>& interfaces);
+int readLinkSpeed(const std::string& name);
+std::string interfaceGroup(const std::string& kind, bool loopback, int peer_netns);
+std::vector<InterfaceGroupStats> summarizeInterfaceGroups(const std::vector<NetworkInterface>& interfaces);
+void benchmarkNetworkInfo(int rounds);
+bool readProtocolStats(ProtocolStats& stats);
+ProtocolRates protocolRatesBetween(const ProtocolStats& prev, const ProtocolStats& curr, float seconds);
+bool dumpSockets(std::vector<SocketInfo>& sockets);
+void resolveSocketOwners(std::vector<SocketInfo>& sockets);
+SocketSummary summarizeSockets(const std::vector<SocketInfo>& sockets);
+const char* socketStateName(const SocketInfo& socket);
+const char* socketProtocolName(const SocketInfo& socket);
+const char* tcpStateName(int state);
+std::string formatSocketAddress(const SocketInfo& socket, bool remote);
+void updateProcessNetwork(const std::vector<SocketInfo>& sockets, std::vector<ProcessNetwork>& processes,
+                          std::vector<CgroupNetwork>& cgroups);
+void updateInterfaceRates(const std::vector<NetworkInterface>& prev, std::vector<NetworkInterface>& curr, float seconds);
 CPUInfo getCPUInfo();
-ThermalInfo getThermalInfo();
-FanInfo getFanInfo();
+bool readCPUTimes(CPUInfo& info);
+float cpuUsageBetween(const CPUInfo& prev, const CPUInfo& curr);
+bool readSensors(std::vector<SensorReading>& sensors);
+void readHeadlineSensors(ThermalInfo& thermal, FanInfo& fan);
+void setPowercapRoot(const std::string& root);
+bool readPowerDomains(std::vector<PowerDomain>& domains);
+void updatePowerRates(const std::vector<PowerDomain>& prev, std::vector<PowerDomain>& curr, float seconds);
+float totalPackageWatts(const std::vector<PowerDomain>& domains);
+void updateProcessEnergy(const std::vector<ProcessInfo>& processes, const std::vector<PowerDomain>& domains,
+                         std::vector<ProcessEnergy>& result);
+ThermalInfo thermalFromSensors(const std::vector<SensorReading>& sensors);
+FanInfo fanFromSensors(const std::vector<SensorReading>& sensors);
+const char* sensorKindName(SensorKind kind);
+const char* sensorUnit(SensorKind kind);
 
 // Utility functions
 std::string formatBytes(unsigned long bytes);
 std::string trim(const std::string& str);
 float calculateCPUUsage();
-void updateGraphData(std::deque<float>& data, float value, int max_points);
+
+// History functions
+void setHistoryCapacity(HistoryRing& ring, size_t capacity);
+void pushHistory(HistoryRing& ring, float value);
+unsigned long long historyOldest(const HistoryRing& ring);
+float historyAt(const HistoryRing& ring, unsigned long long index);
+size_t historyCapacityForBudget(size_t budget_bytes, size_t series);
+
+// Sampler functions
+bool startSampler(const SamplerSettings& settings);
+void stopSampler();
+void addSnapshotListener(const SnapshotListener& listener);
+
+// Scheduler functions
+int addPeriodicTask(float interval_seconds, const std::function<void()>& run);
+void setPeriodicTaskInterval(int task, float interval_seconds);
+void stopScheduler();
+
+// Metrics exporter functions
+bool startMetricsServer(const MetricsSettings& settings);
+void stopMetricsServer();
+MetricsSnapshot collectMetricsSnapshot(CPUInfo& prev_cpu, int top_processes);
+std::string serializeMetrics(const MetricsSnapshot& snapshot);
+
+// Streaming agent and viewer functions
+bool startStreamAgent(const StreamSettings& settings);
+void stopStreamAgent();
+bool startStreamViewer(const std::vector<std::string>& addresses);
+void stopStreamViewer();
+void getRemoteHosts(std::vector<RemoteHost>& hosts);
+
+// Shared-memory publication functions (layout in shm_snapshot.h)
+bool startSharedSnapshot(const std::string& name);
+void stopSharedSnapshot();
 
 // GUI functions
+void requestRedraw();
 void renderSystemMonitor();
 void renderMemoryAndProcessMonitor();
 void renderNetworkMonitor();
-void renderGraph(const std::deque<float>& data, const char* label, float overlay_value, 
+void renderHostGrid();
+void renderGraph(const HistoryRing& history, const char* label, float overlay_value, 
                 ImVec2 size, GraphSettings& settings, const char* overlay_format = "%.1f%%");
+void plotHistory(const char* id, const HistoryRing& history, unsigned long long begin, unsigned long long end,
+                 float scale_min, float scale_max, ImVec2 size, const char* overlay_text = nullptr);
+void plotHistoryGpu(const char* id, const HistoryRing& history, unsigned long long begin, unsigned long long end,
+                    float scale_min, float scale_max, ImVec2 size, const char* overlay_text = nullptr);
+void shutdownGpuPlots();
+
+// GPU frame timing
+bool initGpuTimer();
+void beginGpuTimer();
+void endGpuTimer();
+float gpuFrameMilliseconds();
+void shutdownGpuTimer();
 
 // Global variables
 extern GraphSettings cpu_graph_settings;
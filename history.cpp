@@ -0,0 +1,47 @@
+#include "header.h"
+
+// Samples are addressed by absolute index (0 = first sample ever pushed), so a
+// view can stay anchored to the same samples while new ones keep arriving.
+
+void setHistoryCapacity(HistoryRing& ring, size_t capacity) {
+    // Keep the newest samples that still fit
+    std::vector<float> values;
+    values.reserve(capacity);
+    unsigned long long first = historyOldest(ring);
+    if (ring.total - first > capacity) first = ring.total - capacity;
+    for (unsigned long long i = first; i < ring.total; i++) {
+        values.push_back(historyAt(ring, i));
+    }
+
+    ring.values.swap(values);
+    ring.values.resize(capacity);
+    ring.head = capacity > 0 ? (size_t)(ring.total - first) % capacity : 0;
+
+    // Anything before the kept window is gone
+    ring.dropped = first;
+}
+
+void pushHistory(HistoryRing& ring, float value) {
+    if (ring.values.empty()) return;
+
+    ring.values[ring.head] = value;
+    ring.head = (ring.head + 1) % ring.values.size();
+    ring.total++;
+}
+
+unsigned long long historyOldest(const HistoryRing& ring) {
+    unsigned long long retained = std::min<unsigned long long>(ring.total - ring.dropped, ring.values.size());
+    return ring.total - retained;
+}
+
+float historyAt(const HistoryRing& ring, unsigned long long index) {
+    // Slot of the newest sample is head - 1; walk back from there
+    unsigned long long back = ring.total - index;
+    size_t size = ring.values.size();
+    return ring.values[(ring.head + size - (size_t)(back % size)) % size];
+}
+
+size_t historyCapacityForBudget(size_t budget_bytes, size_t series) {
+    if (series == 0) return 0;
+    return std::max<size_t>(2, budget_bytes / series / sizeof(float));
+}
@@ -1,10 +1,18 @@
 #include "header.h"
 #include <iostream>
+#include <csignal>
+#include <atomic>
+#include <mutex>
+#include <netinet/in.h>
 
 // Global variables
 GraphSettings cpu_graph_settings;
 GraphSettings fan_graph_settings;
 GraphSettings thermal_graph_settings;
+// Remote hosts sample on the agent's schedule; their graphs have no task
+static GraphSettings remote_cpu_graph_settings;
+static GraphSettings remote_fan_graph_settings;
+static GraphSettings remote_thermal_graph_settings;
 std::string process_filter;
 std::vector<int> selected_processes;
 
@@ -12,43 +20,641 @@ std::vector<int> selected_processes;
 static CPUInfo cpu_data;
 static ThermalInfo thermal_data;
 static FanInfo fan_data;
-static auto last_update = std::chrono::steady_clock::now();
 
-void renderGraph(const std::deque<float>& data, const char* label, float overlay_value, 
+// Continuous history written by the collectors, sized from the memory budget
+static HistoryRing cpu_history;
+static HistoryRing thermal_history;
+static HistoryRing fan_history;
+
+// Local data shown by the tabs, written by the collector tasks.
+// monitor_data_mutex is held while a frame is built so the tabs see a consistent view.
+static std::mutex monitor_data_mutex;
+static SystemInfo local_sys_info;
+static MemoryInfo local_mem_info;
+static std::vector<ProcessInfo> local_processes;
+static std::vector<NetworkInterface> local_interfaces;
+
+// Redraw requests from background threads, coalesced into one SDL event
+static Uint32 redraw_event_type = (Uint32)-1;
+static std::atomic<bool> redraw_pending(false);
+
+// Multi-host viewer state, refreshed once per frame
+static std::vector<RemoteHost> remote_hosts;
+static bool gpu_plots = false; // draw history from GPU buffers instead of ImDrawList geometry
+static bool gpu_timing = false; // show the render cost overlay
+static bool streamed_uploads = true;
+static int viewed_host = -1; // -1 shows the local machine
+
+// The remote host the tabs drill into, or nullptr for local data
+static const RemoteHost* viewedRemoteHost() {
+    if (viewed_host < 0 || viewed_host >= (int)remote_hosts.size()) return nullptr;
+    return &remote_hosts[viewed_host];
+}
+
+void requestRedraw() {
+    if (redraw_event_type == (Uint32)-1 || redraw_pending.exchange(true)) return;
+    
+    SDL_Event event = {};
+    event.type = redraw_event_type;
+    SDL_PushEvent(&event);
+}
+
+// Collector tasks, each run by the scheduler on its own interval.
+// The /proc reads happen outside the lock; only publishing the result is locked.
+static void sampleCPU() {
+    CPUInfo sample = getCPUInfo();
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    cpu_data = sample;
+    pushHistory(cpu_history, cpu_data.usage_percent);
+    requestRedraw();
+}
+
+// Every sensor is read once a second for the Sensors tab; the fan and thermal
+// graphs re-read only their two headline sensors, at the faster of the two graph
+// rates. Each graph takes a sample only once its own interval has passed.
+#define SENSOR_SWEEP_SECONDS 1.0f
+
+static std::vector<SensorReading> local_sensors;
+static int sensor_task_id = -1; // the headline task
+static std::atomic<float> fan_sample_interval(1.0f);
+static std::atomic<float> thermal_sample_interval(1.0f);
+static std::chrono::steady_clock::time_point fan_sampled_at, thermal_sampled_at;
+
+static void sampleSensors() {
+    std::vector<SensorReading> sensors;
+    readSensors(sensors);
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    local_sensors.swap(sensors);
+    requestRedraw();
+}
+
+static void sampleHeadlineSensors() {
+    FanInfo fan;
+    ThermalInfo thermal;
+    readHeadlineSensors(thermal, fan);
+    // Scheduler jitter would otherwise skip every other sweep at equal rates
+    auto now = std::chrono::steady_clock::now();
+    bool fan_due = now - fan_sampled_at >= std::chrono::duration<float>(fan_sample_interval * 0.9f);
+    bool thermal_due = now - thermal_sampled_at >= std::chrono::duration<float>(thermal_sample_interval * 0.9f);
+    if (fan_due) fan_sampled_at = now;
+    if (thermal_due) thermal_sampled_at = now;
+
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    bool changed = fan.speed != fan_data.speed || fan.available != fan_data.available ||
+                   thermal.temperature != thermal_data.temperature || thermal.available != thermal_data.available;
+    fan_data = fan;
+    thermal_data = thermal;
+    if (fan_due && fan_data.available) pushHistory(fan_history, fan_data.speed);
+    if (thermal_due && thermal_data.available) pushHistory(thermal_history, thermal_data.temperature);
+    // A redraw only when a graph moved or a value changed
+    if (changed || (fan_due && fan_data.available) || (thermal_due && thermal_data.available)) requestRedraw();
+}
+
+// Rings for devices that come and go (disks, interfaces, power domains) share
+// part of the --history-mb budget. Each gets its full window while the share
+// lasts and whatever is left after that; both are counted under monitor_data_mutex.
+static size_t device_history_budget = 0;
+static size_t device_history_used = 0;
+
+static void setDeviceHistoryCapacity(HistoryRing& ring, size_t points) {
+    size_t left = device_history_budget > device_history_used ? device_history_budget - device_history_used : 0;
+    size_t capacity = std::min(points, std::max<size_t>(2, left / sizeof(float)));
+    setHistoryCapacity(ring, capacity);
+    device_history_used += capacity * sizeof(float);
+}
+
+static void releaseDeviceHistory(const HistoryRing& ring) {
+    device_history_used -= std::min(device_history_used, ring.values.size() * sizeof(float));
+}
+
+// RAPL power per domain with a history window each, sampled once a second
+#define POWER_HISTORY_POINTS 300
+
+struct PowerGraph {
+    HistoryRing history; // watts
+    bool present = false;
+};
+
+static std::vector<PowerDomain> power_domains;
+static std::map<std::string, PowerGraph> power_graphs;
+static HistoryRing package_power_history;
+static double package_energy_joules = 0.0; // since we started
+static std::atomic<float> package_watts(-1.0f); // -1 until RAPL has been read twice
+static std::vector<ProcessEnergy> process_energy;
+
+static void samplePower() {
+    static std::vector<PowerDomain> prev;
+    static std::chrono::steady_clock::time_point prev_time;
+    
+    std::vector<PowerDomain> sample;
+    if (!readPowerDomains(sample)) return;
+    auto now = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(now - prev_time).count();
+    bool has_rates = !prev.empty();
+    if (has_rates) {
+        updatePowerRates(prev, sample, seconds);
+    }
+    prev = sample;
+    prev_time = now;
+    float watts = totalPackageWatts(sample);
+    
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    for (auto& entry : power_graphs) {
+        entry.second.present = false;
+    }
+    for (const PowerDomain& domain : sample) {
+        PowerGraph& graph = power_graphs[domain.zone];
+        if (graph.history.values.empty()) {
+            setDeviceHistoryCapacity(graph.history, POWER_HISTORY_POINTS);
+        }
+        graph.present = true;
+        if (has_rates && domain.readable) pushHistory(graph.history, domain.watts);
+    }
+    for (auto it = power_graphs.begin(); it != power_graphs.end(); ) {
+        if (it->second.present) {
+            ++it;
+            continue;
+        }
+        releaseDeviceHistory(it->second.history);
+        it = power_graphs.erase(it);
+    }
+    if (has_rates) {
+        if (package_power_history.values.empty()) setDeviceHistoryCapacity(package_power_history, POWER_HISTORY_POINTS);
+        pushHistory(package_power_history, watts);
+        package_energy_joules += watts * seconds;
+        package_watts = watts;
+    }
+    power_domains.swap(sample);
+    requestRedraw();
+}
+
+static void sampleMemoryAndProcesses() {
+    SampleContext context = makeSampleContext();
+    MemoryInfo mem_sample = getMemoryInfo();
+    context.memory = &mem_sample;
+    std::vector<ProcessInfo> process_sample = getProcesses(context);
+    context.processes = &process_sample;
+    SystemInfo sys_sample = getSystemInfo(context);
+    // Package power split by CPU time, once RAPL has given a reading
+    std::vector<ProcessEnergy> energy_sample;
+    if (package_watts >= 0.0f) {
+        std::vector<PowerDomain> domains;
+        {
+            std::lock_guard<std::mutex> lock(monitor_data_mutex);
+            domains = power_domains;
+        }
+        updateProcessEnergy(process_sample, domains, energy_sample);
+    }
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    local_sys_info = sys_sample;
+    local_mem_info = mem_sample;
+    local_processes.swap(process_sample);
+    process_energy.swap(energy_sample);
+    requestRedraw();
+}
+
+// Kernel VM activity rates with a graph each, sampled once a second
+struct VmGraph {
+    const char* label;
+    float VmStatRates::* rate;
+    HistoryRing history;
+};
+
+static VmGraph vm_graphs[] = {
+    {"Major faults/s", &VmStatRates::pgmajfault, {}},
+    {"Page faults/s", &VmStatRates::pgfault, {}},
+    {"Swap in pages/s", &VmStatRates::pswpin, {}},
+    {"Swap out pages/s", &VmStatRates::pswpout, {}},
+    {"Direct reclaim stalls/s", &VmStatRates::allocstall, {}},
+    {"Direct reclaim scans/s", &VmStatRates::pgscan_direct, {}},
+};
+static const int VM_GRAPH_COUNT = sizeof(vm_graphs) / sizeof(vm_graphs[0]);
+static VmStatRates vm_rates;
+
+static void sampleVmStat() {
+    static VmStatInfo prev;
+    static std::chrono::steady_clock::time_point prev_time;
+    static bool has_prev = false;
+    
+    VmStatInfo curr;
+    if (!readVmStat(curr)) return;
+    auto now = std::chrono::steady_clock::now();
+    
+    // Rates need two samples
+    if (has_prev) {
+        VmStatRates rates = vmStatRatesBetween(prev, curr, std::chrono::duration<float>(now - prev_time).count());
+        std::lock_guard<std::mutex> lock(monitor_data_mutex);
+        vm_rates = rates;
+        for (VmGraph& graph : vm_graphs) {
+            pushHistory(graph.history, rates.*graph.rate);
+        }
+        requestRedraw();
+    }
+    prev = curr;
+    prev_time = now;
+    has_prev = true;
+}
+
+// Block device activity, one history window per device, sampled once a second
+#define DISK_HISTORY_POINTS 300
+
+struct DiskGraph {
+    DiskRates rates;
+    HistoryRing read_history; // bytes per second
+    HistoryRing write_history;
+    HistoryRing util_history; // percent
+    bool present = false;
+};
+
+static std::map<std::string, DiskGraph> disk_graphs;
+static std::atomic<bool> disk_physical_only(true); // hide partitions and software layers
+static std::string selected_disk;
+
+static void sampleDiskStats() {
+    static std::map<std::string, DiskStats> prev;
+    static std::chrono::steady_clock::time_point prev_time;
+    
+    std::vector<DiskStats> disks;
+    if (!readDiskStats(disks, disk_physical_only)) return;
+    auto now = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(now - prev_time).count();
+    
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    for (auto& entry : disk_graphs) {
+        entry.second.present = false;
+    }
+    std::map<std::string, DiskStats> curr;
+    for (const DiskStats& disk : disks) {
+        curr[disk.name] = disk;
+        DiskGraph& graph = disk_graphs[disk.name];
+        if (graph.read_history.values.empty()) {
+            setDeviceHistoryCapacity(graph.read_history, DISK_HISTORY_POINTS);
+            setDeviceHistoryCapacity(graph.write_history, DISK_HISTORY_POINTS);
+            setDeviceHistoryCapacity(graph.util_history, DISK_HISTORY_POINTS);
+        }
+        graph.present = true;
+        
+        // Rates need two samples of the same device
+        auto before = prev.find(disk.name);
+        if (before == prev.end()) continue;
+        graph.rates = diskRatesBetween(before->second, disk, seconds);
+        pushHistory(graph.read_history, graph.rates.read_bytes);
+        pushHistory(graph.write_history, graph.rates.write_bytes);
+        pushHistory(graph.util_history, graph.rates.utilization);
+    }
+    
+    // Forget devices that went away or were hidden
+    for (auto it = disk_graphs.begin(); it != disk_graphs.end(); ) {
+        if (it->second.present) {
+            ++it;
+            continue;
+        }
+        releaseDeviceHistory(it->second.read_history);
+        releaseDeviceHistory(it->second.write_history);
+        releaseDeviceHistory(it->second.util_history);
+        it = disk_graphs.erase(it);
+    }
+    prev.swap(curr);
+    prev_time = now;
+    requestRedraw();
+}
+
+static std::vector<NumaNode> numa_nodes;
+
+static void sampleNuma() {
+    static std::vector<NumaNode> nodes;
+    if (!updateNumaNodes(nodes)) return;
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    numa_nodes = nodes;
+    requestRedraw();
+}
+
+// Receive and transmit rate history for each local interface
+#define NETWORK_HISTORY_POINTS 300
+
+struct InterfaceGraph {
+    HistoryRing rx_history; // bytes per second
+    HistoryRing tx_history;
+    bool present = false;
+};
+
+static std::map<std::string, InterfaceGraph> interface_graphs;
+static std::vector<InterfaceGroupStats> local_interface_groups;
+
+static void sampleNetwork() {
+    static std::vector<NetworkInterface> prev;
+    static std::chrono::steady_clock::time_point prev_time;
+    
+    std::vector<NetworkInterface> sample = getNetworkInfo();
+    auto now = std::chrono::steady_clock::now();
+    bool has_rates = !prev.empty();
+    if (has_rates) {
+        updateInterfaceRates(prev, sample, std::chrono::duration<float>(now - prev_time).count());
+    }
+    prev = sample;
+    prev_time = now;
+    std::vector<InterfaceGroupStats> groups = summarizeInterfaceGroups(sample);
+    
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    local_interface_groups.swap(groups);
+    for (auto& entry : interface_graphs) {
+        entry.second.present = false;
+    }
+    for (const NetworkInterface& iface : sample) {
+        InterfaceGraph& graph = interface_graphs[iface.name];
+        if (graph.rx_history.values.empty()) {
+            setDeviceHistoryCapacity(graph.rx_history, NETWORK_HISTORY_POINTS);
+            setDeviceHistoryCapacity(graph.tx_history, NETWORK_HISTORY_POINTS);
+        }
+        graph.present = true;
+        if (has_rates) {
+            pushHistory(graph.rx_history, iface.rx_bytes_rate);
+            pushHistory(graph.tx_history, iface.tx_bytes_rate);
+        }
+    }
+    for (auto it = interface_graphs.begin(); it != interface_graphs.end(); ) {
+        if (it->second.present) {
+            ++it;
+            continue;
+        }
+        releaseDeviceHistory(it->second.rx_history);
+        releaseDeviceHistory(it->second.tx_history);
+        it = interface_graphs.erase(it);
+    }
+    local_interfaces.swap(sample);
+    requestRedraw();
+}
+
+// TCP and UDP trouble counters with a graph each, sampled once a second
+struct ProtocolGraph {
+    const char* label;
+    float ProtocolRates::* rate;
+    HistoryRing history;
+};
+
+static ProtocolGraph protocol_graphs[] = {
+    {"Retransmits/s", &ProtocolRates::tcp_retrans_segs, {}},
+    {"RTO timeouts/s", &ProtocolRates::tcp_timeouts, {}},
+    {"Listen overflows/s", &ProtocolRates::listen_overflows, {}},
+    {"Listen drops/s", &ProtocolRates::listen_drops, {}},
+    {"Resets sent/s", &ProtocolRates::tcp_out_rsts, {}},
+    {"TCP receive errors/s", &ProtocolRates::tcp_in_errs, {}},
+    {"UDP receive errors/s", &ProtocolRates::udp_in_errors, {}},
+    {"UDP buffer drops/s", &ProtocolRates::udp_rcvbuf_errors, {}},
+};
+static const int PROTOCOL_GRAPH_COUNT = sizeof(protocol_graphs) / sizeof(protocol_graphs[0]);
+static ProtocolStats protocol_stats;
+static ProtocolRates protocol_rates;
+
+static void sampleProtocolStats() {
+    static ProtocolStats prev;
+    static std::chrono::steady_clock::time_point prev_time;
+    static bool has_prev = false;
+    
+    ProtocolStats curr;
+    if (!readProtocolStats(curr)) return;
+    auto now = std::chrono::steady_clock::now();
+    
+    // Rates need two samples
+    if (has_prev) {
+        ProtocolRates rates = protocolRatesBetween(prev, curr, std::chrono::duration<float>(now - prev_time).count());
+        std::lock_guard<std::mutex> lock(monitor_data_mutex);
+        protocol_stats = curr;
+        protocol_rates = rates;
+        for (ProtocolGraph& graph : protocol_graphs) {
+            pushHistory(graph.history, rates.*graph.rate);
+        }
+        requestRedraw();
+    }
+    prev = curr;
+    prev_time = now;
+    has_prev = true;
+}
+
+// Socket inventory and per-process traffic; dumped only while the Connections
+// or Process Traffic tab is on screen
+static std::vector<SocketInfo> local_sockets;
+static SocketSummary local_socket_summary;
+static std::vector<ProcessNetwork> local_process_network;
+static std::vector<CgroupNetwork> local_cgroup_network;
+static unsigned long long socket_generation = 0; // bumped by every dump
+static std::atomic<bool> connections_visible(false);
+static bool connections_shown = false; // set by the frame being drawn
+
+static void sampleConnections() {
+    static std::vector<SocketInfo> sockets; // the previous dump, reused for its capacity
+    if (!connections_visible) return;
+    if (!dumpSockets(sockets)) return;
+    resolveSocketOwners(sockets);
+    SocketSummary summary = summarizeSockets(sockets);
+    std::vector<ProcessNetwork> processes;
+    std::vector<CgroupNetwork> cgroups;
+    updateProcessNetwork(sockets, processes, cgroups);
+    
+    std::lock_guard<std::mutex> lock(monitor_data_mutex);
+    local_sockets.swap(sockets);
+    local_socket_summary = summary;
+    local_process_network.swap(processes);
+    local_cgroup_network.swap(cgroups);
+    socket_generation++;
+    requestRedraw();
+}
+
+static float sampleInterval(const GraphSettings& settings) {
+    return 1.0f / settings.sample_rate;
+}
+
+static void retimeSensorTask() {
+    fan_sample_interval = sampleInterval(fan_graph_settings);
+    thermal_sample_interval = sampleInterval(thermal_graph_settings);
+    setPeriodicTaskInterval(sensor_task_id, std::min<float>(fan_sample_interval, thermal_sample_interval));
+}
+
+void renderGraph(const HistoryRing& history, const char* label, float overlay_value, 
                 ImVec2 size, GraphSettings& settings, const char* overlay_format) {
     
     ImGui::Text("%s", label);
     
-    // Graph controls
-    ImGui::Checkbox(("Animate##" + std::string(label)).c_str(), &settings.animate);
-    ImGui::SameLine();
-    ImGui::SliderFloat(("FPS##" + std::string(label)).c_str(), &settings.fps, 1.0f, 60.0f);
-    ImGui::SliderFloat(("Y Scale##" + std::string(label)).c_str(), &settings.y_scale, 10.0f, 200.0f);
+    // Graph controls; sampling runs on its own schedule, independent of the frame rate
+    ImGui::PushID(label);
+    if (ImGui::Checkbox("Animate", &settings.animate) && !settings.animate) {
+        settings.frozen_at = history.total;
+    }
+    if (settings.task_id >= 0) {
+        ImGui::SameLine();
+        if (ImGui::SliderFloat("Sample Hz", &settings.sample_rate, 0.2f, 100.0f)) {
+            if (settings.task_id == sensor_task_id) {
+                retimeSensorTask();
+            } else {
+                setPeriodicTaskInterval(settings.task_id, sampleInterval(settings));
+            }
+        }
+    }
+    ImGui::SliderFloat("Y Scale", &settings.y_scale, 10.0f, 200.0f);
+    ImGui::SliderInt("Window", &settings.max_points, 50, std::max<int>(50, history.values.size()), "%d samples",
+                     ImGuiSliderFlags_Logarithmic);
     
-    // Convert deque to vector for ImGui
-    std::vector<float> plot_data(data.begin(), data.end());
+    // Newest max_points samples, or the ones on screen when animation was paused
+    unsigned long long end = settings.animate ? history.total : std::min(settings.frozen_at, history.total);
+    unsigned long long begin = end > (unsigned long long)settings.max_points ? end - settings.max_points : 0;
     
     // Create overlay text
     char overlay_text[64];
     snprintf(overlay_text, sizeof(overlay_text), overlay_format, overlay_value);
     
-    ImGui::PlotLines(("##" + std::string(label)).c_str(), 
-                     plot_data.data(), plot_data.size(), 0, overlay_text, 
-                     0.0f, settings.y_scale, size);
+    (gpu_plots ? plotHistoryGpu : plotHistory)("plot", history, begin, end, 0.0f, settings.y_scale, size, overlay_text);
+    ImGui::PopID();
 }
 
-void renderSystemMonitor() {
-    static SystemInfo sys_info;
-    static auto last_sys_update = std::chrono::steady_clock::now();
+// Corner overlay with the GPU cost of the ImGui pass, to compare buffer upload paths
+static void renderGpuTimingOverlay() {
+    ImGuiIO& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 10.0f, 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.6f);
+    if (ImGui::Begin("GPU timing", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+                                           ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav)) {
+        ImGui::Text("GPU: %.3f ms", gpuFrameMilliseconds());
+        ImGui::Text("%d vertices, %d indices", io.MetricsRenderVertices, io.MetricsRenderIndices);
+        if (ImGui::Checkbox("Streamed uploads", &streamed_uploads)) {
+            ImGui_ImplOpenGL3_SetStreamedUploads(streamed_uploads);
+        }
+    }
+    ImGui::End();
+}
+
+static void renderPowerGraph(const char* id, const HistoryRing& history, const char* label, float watts) {
+    unsigned long long end = history.total;
+    unsigned long long begin = historyOldest(history);
+    float peak = 1.0f;
+    for (unsigned long long h = begin; h < end; h++) {
+        peak = std::max(peak, historyAt(history, h));
+    }
+    char overlay[96];
+    snprintf(overlay, sizeof(overlay), "%s %.1f W (peak %.1f W)", label, watts, peak);
+    (gpu_plots ? plotHistoryGpu : plotHistory)(id, history, begin, end, 0.0f, peak * 1.1f, ImVec2(-1.0f, 60.0f), overlay);
+}
+
+static void renderPower() {
+    if (power_domains.empty()) {
+        ImGui::TextDisabled("No RAPL power domains found in /sys/class/powercap");
+        return;
+    }
+    bool any_readable = std::any_of(power_domains.begin(), power_domains.end(), [](const PowerDomain& d) { return d.readable; });
+    if (!any_readable) {
+        ImGui::TextDisabled("RAPL energy counters are not readable; recent kernels allow root only");
+        return;
+    }
     
-    auto now = std::chrono::steady_clock::now();
-    auto sys_elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - last_sys_update);
+    float watts = package_watts;
+    ImGui::Text("Package power: %.1f W   Energy since start: %.3f Wh", std::max(0.0f, watts), package_energy_joules / 3600.0);
+    renderPowerGraph("package", package_power_history, "Package", std::max(0.0f, watts));
+    
+    // Subdomains are indented under their package
+    if (ImGui::BeginTable("PowerDomains", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Domain", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+        ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        for (const PowerDomain& domain : power_domains) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            if (!domain.top_level) ImGui::Indent();
+            ImGui::Text("%s", domain.name.c_str());
+            ImGui::TextDisabled("%s", domain.zone.c_str());
+            if (!domain.top_level) ImGui::Unindent();
+            ImGui::TableSetColumnIndex(1);
+            auto graph = power_graphs.find(domain.zone);
+            if (!domain.readable) {
+                ImGui::TextDisabled("not readable");
+            } else if (graph != power_graphs.end() && graph->second.history.total >= 2) {
+                ImGui::PushID(domain.zone.c_str());
+                renderPowerGraph("domain", graph->second.history, domain.name.c_str(), domain.watts);
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+    
+    // Estimated from each process's share of busy CPU time
+    ImGui::Text("Estimated power by process:");
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("ProcessPower", 5, flags, ImVec2(0.0f, 250.0f))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("PID");
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("CPU share");
+        ImGui::TableSetupColumn("Watts");
+        ImGui::TableSetupColumn("Energy");
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin((int)process_energy.size());
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const ProcessEnergy& energy = process_energy[row];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0); ImGui::Text("%d", energy.pid);
+                ImGui::TableSetColumnIndex(1); ImGui::Text("%s", energy.name.c_str());
+                ImGui::TableSetColumnIndex(2); ImGui::Text("%.1f%%", energy.cpu_share_percent);
+                ImGui::TableSetColumnIndex(3); ImGui::Text("%.2f W", energy.watts);
+                ImGui::TableSetColumnIndex(4); ImGui::Text("%.1f J", energy.joules);
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+static void renderSensors() {
+    if (local_sensors.empty()) {
+        ImGui::TextDisabled("No sensor found in /sys/class/thermal or /sys/class/hwmon");
+        return;
+    }
     
-    // Update system info every 5 seconds
-    if (sys_elapsed.count() >= 5) {
-        sys_info = getSystemInfo();
-        last_sys_update = now;
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (!ImGui::BeginTable("Sensors", 5, flags, ImVec2(0.0f, 300.0f))) return;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Chip");
+    ImGui::TableSetupColumn("Sensor");
+    ImGui::TableSetupColumn("Value");
+    ImGui::TableSetupColumn("Limits");
+    ImGui::TableSetupColumn("Usage of limit", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableHeadersRow();
+    
+    for (const SensorReading& sensor : local_sensors) {
+        const char* unit = sensorUnit(sensor.kind);
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0); ImGui::Text("%s", sensor.chip.c_str());
+        if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s", sensor.device.c_str());
+        ImGui::TableSetColumnIndex(1); ImGui::Text("%s", sensor.label.c_str());
+        ImGui::TableSetColumnIndex(2);
+        if (!sensor.valid) {
+            ImGui::TextDisabled("unreadable");
+        } else if (sensor.kind == SENSOR_FAN) {
+            ImGui::Text("%.0f %s", sensor.value, unit);
+        } else {
+            ImGui::Text("%.2f %s", sensor.value, unit);
+        }
+        ImGui::TableSetColumnIndex(3);
+        if (sensor.minimum > 0.0f && sensor.critical > 0.0f) {
+            ImGui::Text("%.1f - %.1f", sensor.minimum, sensor.critical);
+        } else if (sensor.critical > 0.0f) {
+            ImGui::Text("max %.1f", sensor.critical);
+        } else if (sensor.minimum > 0.0f) {
+            ImGui::Text("min %.1f", sensor.minimum);
+        }
+        ImGui::TableSetColumnIndex(4);
+        if (sensor.valid && sensor.critical > 0.0f) {
+            float fraction = std::min(1.0f, std::max(0.0f, sensor.value / sensor.critical));
+            bool hot = fraction >= 0.9f || (sensor.minimum > 0.0f && sensor.value < sensor.minimum);
+            if (hot) ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.9f, 0.3f, 0.2f, 1.0f));
+            ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f));
+            if (hot) ImGui::PopStyleColor();
+        }
     }
+    ImGui::EndTable();
+}
+
+void renderSystemMonitor() {
+    const RemoteHost* remote = viewedRemoteHost();
+    const SystemInfo& sys_info = remote ? remote->snapshot.system : local_sys_info;
     
     ImGui::Text("System Information");
     ImGui::Separator();
@@ -74,85 +680,437 @@ void renderSystemMonitor() {
         
         // CPU Tab
         if (ImGui::BeginTabItem("CPU")) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update);
-            float target_interval = 1000.0f / cpu_graph_settings.fps;
-            
-            if (cpu_graph_settings.animate && elapsed.count() >= target_interval) {
-                cpu_data = getCPUInfo();
-                updateGraphData(cpu_data.usage_history, cpu_data.usage_percent, cpu_graph_settings.max_points);
-            }
-            
-            renderGraph(cpu_data.usage_history, "CPU Usage", cpu_data.usage_percent, 
-                       ImVec2(0, 200), cpu_graph_settings, "%.1f%%");
+            const CPUInfo& cpu = remote ? remote->snapshot.cpu : cpu_data;
+            renderGraph(remote ? remote->cpu_history : cpu_history, "CPU Usage", cpu.usage_percent, 
+                       ImVec2(0, 200), remote ? remote_cpu_graph_settings : cpu_graph_settings, "%.1f%%");
             
             ImGui::EndTabItem();
         }
         
         // Fan Tab
         if (ImGui::BeginTabItem("Fan")) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update);
-            float target_interval = 1000.0f / fan_graph_settings.fps;
-            
-            if (fan_graph_settings.animate && elapsed.count() >= target_interval) {
-                fan_data = getFanInfo();
-                updateGraphData(fan_data.speed_history, fan_data.speed, fan_graph_settings.max_points);
+            const FanInfo& fan = remote ? remote->snapshot.fan : fan_data;
+            if (fan.available) {
+                ImGui::Text("Status: %s (%s)", fan.active ? "Active" : "Inactive", fan.source.c_str());
+                ImGui::Text("Speed: %d RPM", fan.speed);
+                if (fan.level >= 0) {
+                    ImGui::Text("Duty cycle: %d%%", fan.level);
+                }
+                
+                renderGraph(remote ? remote->fan_history : fan_history, "Fan Speed", fan.speed, 
+                           ImVec2(0, 200), remote ? remote_fan_graph_settings : fan_graph_settings, "%.0f RPM");
+            } else {
+                ImGui::TextDisabled("No fan sensor found");
             }
             
-            ImGui::Text("Status: %s", fan_data.active ? "Active" : "Inactive");
-            ImGui::Text("Speed: %d RPM", fan_data.speed);
-            ImGui::Text("Level: %d", fan_data.level);
-            
-            renderGraph(fan_data.speed_history, "Fan Speed", fan_data.speed, 
-                       ImVec2(0, 200), fan_graph_settings, "%.0f RPM");
-            
             ImGui::EndTabItem();
         }
         
         // Thermal Tab
         if (ImGui::BeginTabItem("Thermal")) {
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update);
-            float target_interval = 1000.0f / thermal_graph_settings.fps;
-            
-            if (thermal_graph_settings.animate && elapsed.count() >= target_interval) {
-                thermal_data = getThermalInfo();
-                updateGraphData(thermal_data.temp_history, thermal_data.temperature, thermal_graph_settings.max_points);
+            const ThermalInfo& thermal = remote ? remote->snapshot.thermal : thermal_data;
+            if (thermal.available) {
+                ImGui::Text("Sensor: %s", thermal.source.c_str());
+                if (thermal.critical > 0.0f) {
+                    ImGui::SameLine();
+                    ImGui::Text("  critical at %.0f°C", thermal.critical);
+                }
+                renderGraph(remote ? remote->thermal_history : thermal_history, "Temperature", thermal.temperature, 
+                           ImVec2(0, 200), remote ? remote_thermal_graph_settings : thermal_graph_settings, "%.1f°C");
+            } else {
+                ImGui::TextDisabled("No temperature sensor found");
             }
             
-            renderGraph(thermal_data.temp_history, "Temperature", thermal_data.temperature, 
-                       ImVec2(0, 200), thermal_graph_settings, "%.1f°C");
-            
+            ImGui::EndTabItem();
+        }
+        
+        // Every thermal zone and hwmon channel on this machine
+        if (!remote && ImGui::BeginTabItem("Sensors")) {
+            renderSensors();
+            ImGui::EndTabItem();
+        }
+        
+        if (!remote && ImGui::BeginTabItem("Power")) {
+            renderPower();
             ImGui::EndTabItem();
         }
         
         ImGui::EndTabBar();
     }
+}
+
+// Stacked bar splitting physical memory by what holds it, with a legend.
+// Cache and reclaimable slab count as available; shmem and unreclaimable slab do not.
+static void renderMemoryBreakdown(const MemoryInfo& mem_info) {
+    if (mem_info.total_ram == 0) return;
+
+    unsigned long page_cache = mem_info.cached > mem_info.shmem ? mem_info.cached - mem_info.shmem : 0;
+    unsigned long slab_unreclaimable = mem_info.slab > mem_info.slab_reclaimable ? mem_info.slab - mem_info.slab_reclaimable : 0;
+
+    // Whatever meminfo does not itemize (page tables, kernel stacks, drivers)
+    unsigned long itemized = mem_info.anon_pages + mem_info.shmem + slab_unreclaimable + page_cache +
+                             mem_info.buffers + mem_info.slab_reclaimable + mem_info.free_ram;
+    unsigned long other = mem_info.total_ram > itemized ? mem_info.total_ram - itemized : 0;
+
+    const struct { const char* label; unsigned long kb; ImU32 color; } parts[] = {
+        {"Applications", mem_info.anon_pages, IM_COL32(220, 90, 70, 255)},
+        {"Shared / tmpfs", mem_info.shmem, IM_COL32(230, 160, 60, 255)},
+        {"Kernel slab", slab_unreclaimable, IM_COL32(170, 110, 200, 255)},
+        {"Other kernel", other, IM_COL32(130, 130, 130, 255)},
+        {"Page cache", page_cache, IM_COL32(80, 150, 220, 255)},
+        {"Buffers", mem_info.buffers, IM_COL32(90, 190, 210, 255)},
+        {"Reclaimable slab", mem_info.slab_reclaimable, IM_COL32(120, 180, 150, 255)},
+        {"Free", mem_info.free_ram, IM_COL32(60, 70, 80, 255)},
+    };
+    const int part_count = sizeof(parts) / sizeof(parts[0]);
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = ImGui::CalcItemWidth();
+    float height = ImGui::GetFrameHeight();
+    ImGui::InvisibleButton("##memory_breakdown", ImVec2(width, height));
+    bool hovered = ImGui::IsItemHovered();
+    float mouse_x = ImGui::GetIO().MousePos.x;
+
+    float x = origin.x;
+    for (int i = 0; i < part_count; i++) {
+        unsigned long kb = parts[i].kb;
+        float part_width = width * (float)kb / mem_info.total_ram;
+        draw_list->AddRectFilled(ImVec2(x, origin.y), ImVec2(x + part_width, origin.y + height), parts[i].color);
+        if (hovered && mouse_x >= x && mouse_x < x + part_width) {
+            ImGui::SetTooltip("%s: %s", parts[i].label, formatBytes(kb * 1024).c_str());
+        }
+        x += part_width;
+    }
+
+    // Legend, four entries per row
+    for (int i = 0; i < part_count; i++) {
+        unsigned long kb = parts[i].kb;
+        if (i % 4 != 0) ImGui::SameLine(0.0f, 20.0f);
+        ImVec2 swatch = ImGui::GetCursorScreenPos();
+        float size = ImGui::GetTextLineHeight();
+        draw_list->AddRectFilled(swatch, ImVec2(swatch.x + size, swatch.y + size), parts[i].color);
+        ImGui::Dummy(ImVec2(size, size));
+        ImGui::SameLine();
+        ImGui::Text("%s %s", parts[i].label, formatBytes(kb * 1024).c_str());
+    }
+
+    ImGui::Text("Available: %s", formatBytes(mem_info.available_ram * 1024).c_str());
+    ImGui::SameLine(0.0f, 20.0f);
+    ImGui::Text("Dirty: %s", formatBytes(mem_info.dirty * 1024).c_str());
+    ImGui::SameLine(0.0f, 20.0f);
+    ImGui::Text("Writeback: %s", formatBytes(mem_info.writeback * 1024).c_str());
+    ImGui::SameLine(0.0f, 20.0f);
+    ImGui::Text("Mapped: %s", formatBytes(mem_info.mapped * 1024).c_str());
+    ImGui::Text("Committed: %s of %s limit", formatBytes(mem_info.committed_as * 1024).c_str(),
+                formatBytes(mem_info.commit_limit * 1024).c_str());
+    if (mem_info.hugepages_total > 0) {
+        ImGui::Text("Huge pages: %lu total, %lu free, %lu reserved, %lu surplus (%s each)",
+                    mem_info.hugepages_total, mem_info.hugepages_free, mem_info.hugepages_reserved,
+                    mem_info.hugepages_surplus, formatBytes(mem_info.hugepage_size * 1024).c_str());
+    }
+}
+
+// Reclaim and fault rates for the local machine; the graphs autoscale to the last five minutes
+static void renderVmActivity() {
+    if (!ImGui::CollapsingHeader("Kernel VM Activity")) return;
+    
+    // Stalls and direct scans mean allocating tasks are doing reclaim themselves
+    bool under_pressure = vm_rates.allocstall > 0.0f || vm_rates.pgscan_direct > 0.0f || vm_rates.oom_kill > 0.0f;
+    if (under_pressure) {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "Reclaim pressure: %.0f stalls/s, %.0f pages scanned/s directly",
+                           vm_rates.allocstall, vm_rates.pgscan_direct);
+    } else {
+        ImGui::Text("No direct reclaim");
+    }
+    ImGui::Text("kswapd: %.0f scanned/s, %.0f reclaimed/s   direct: %.0f reclaimed/s", vm_rates.pgscan_kswapd,
+                vm_rates.pgsteal_kswapd, vm_rates.pgsteal_direct);
+    ImGui::Text("Compaction stalls: %.1f/s   THP: %.1f alloc/s, %.1f fallback/s, %.1f collapse/s, %.1f split/s",
+                vm_rates.compact_stall, vm_rates.thp_fault_alloc, vm_rates.thp_fault_fallback,
+                vm_rates.thp_collapse_alloc, vm_rates.thp_split_page);
+    if (vm_rates.oom_kill > 0.0f) {
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "OOM kills: %.1f/s", vm_rates.oom_kill);
+    }
     
-    // Update last_update time
-    if (cpu_graph_settings.animate || fan_graph_settings.animate || thermal_graph_settings.animate) {
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update);
-        float min_interval = std::min({1000.0f / cpu_graph_settings.fps, 
-                                      1000.0f / fan_graph_settings.fps, 
-                                      1000.0f / thermal_graph_settings.fps});
-        if (elapsed.count() >= min_interval) {
-            last_update = now;
+    if (ImGui::BeginTable("VmGraphs", 2)) {
+        for (int i = 0; i < VM_GRAPH_COUNT; i++) {
+            const VmGraph& graph = vm_graphs[i];
+            unsigned long long end = graph.history.total;
+            unsigned long long begin = std::max(historyOldest(graph.history), end > 300 ? end - 300 : 0);
+            float peak = 1.0f;
+            for (unsigned long long h = begin; h < end; h++) {
+                peak = std::max(peak, historyAt(graph.history, h));
+            }
+            
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "%s %.1f (peak %.0f)", graph.label, vm_rates.*graph.rate, peak);
+            ImGui::TableNextColumn();
+            ImGui::PushID(i);
+            (gpu_plots ? plotHistoryGpu : plotHistory)("vm", graph.history, begin, end, 0.0f, peak * 1.1f,
+                                                       ImVec2(-1.0f, 60.0f), overlay);
+            ImGui::PopID();
         }
+        ImGui::EndTable();
     }
 }
 
-void renderMemoryAndProcessMonitor() {
-    static MemoryInfo mem_info;
-    static std::vector<ProcessInfo> processes;
-    static auto last_mem_update = std::chrono::steady_clock::now();
+// Autoscaled graph of everything a device's ring holds
+static void renderDiskGraph(const char* id, const HistoryRing& history, const char* label, bool bytes) {
+    unsigned long long end = history.total;
+    unsigned long long begin = historyOldest(history);
+    float peak = bytes ? 1024.0f : 100.0f;
+    for (unsigned long long h = begin; h < end; h++) {
+        peak = std::max(peak, historyAt(history, h));
+    }
     
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - last_mem_update);
+    float latest = end > 0 ? historyAt(history, end - 1) : 0.0f;
+    char overlay[96];
+    if (bytes) {
+        snprintf(overlay, sizeof(overlay), "%s %s/s (peak %s/s)", label, formatBytes((unsigned long)latest).c_str(),
+                 formatBytes((unsigned long)peak).c_str());
+    } else {
+        snprintf(overlay, sizeof(overlay), "%s %.1f%%", label, latest);
+    }
+    ImGui::TableNextColumn();
+    (gpu_plots ? plotHistoryGpu : plotHistory)(id, history, begin, end, 0.0f, peak * 1.1f, ImVec2(-1.0f, 60.0f), overlay);
+}
+
+// Per-device I/O load for the local machine; click a device for its graphs
+static void renderDiskActivity() {
+    if (!ImGui::CollapsingHeader("Disk I/O")) return;
+    
+    bool physical_only = disk_physical_only;
+    if (ImGui::Checkbox("Hide partitions and virtual devices", &physical_only)) {
+        disk_physical_only = physical_only;
+    }
+    if (disk_graphs.empty()) {
+        ImGui::TextDisabled("No block devices found");
+        return;
+    }
+    
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    float height = std::min(disk_graphs.size() + 1, (size_t)12) * ImGui::GetFrameHeightWithSpacing();
+    if (ImGui::BeginTable("DiskStats", 9, flags, ImVec2(0.0f, height))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Device", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Read IOPS", ImGuiTableColumnFlags_WidthFixed, 75.0f);
+        ImGui::TableSetupColumn("Write IOPS", ImGuiTableColumnFlags_WidthFixed, 75.0f);
+        ImGui::TableSetupColumn("Read/s", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Write/s", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Queue", ImGuiTableColumnFlags_WidthFixed, 55.0f);
+        ImGui::TableSetupColumn("In flight", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Util %", ImGuiTableColumnFlags_WidthFixed, 55.0f);
+        ImGui::TableSetupColumn("Await ms", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableHeadersRow();
+        
+        // Hundreds of devices: only build the visible rows
+        std::vector<const std::pair<const std::string, DiskGraph>*> rows;
+        for (const auto& entry : disk_graphs) rows.push_back(&entry);
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const std::string& name = rows[row]->first;
+                const DiskRates& rates = rows[row]->second.rates;
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                if (ImGui::Selectable(name.c_str(), selected_disk == name, ImGuiSelectableFlags_SpanAllColumns)) {
+                    selected_disk = selected_disk == name ? "" : name;
+                }
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%.0f", rates.read_iops);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.0f", rates.write_iops);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%s", formatBytes((unsigned long)rates.read_bytes).c_str());
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%s", formatBytes((unsigned long)rates.write_bytes).c_str());
+                ImGui::TableSetColumnIndex(5);
+                ImGui::Text("%.2f", rates.queue_depth);
+                ImGui::TableSetColumnIndex(6);
+                ImGui::Text("%lu", rates.in_flight);
+                ImGui::TableSetColumnIndex(7);
+                if (rates.utilization >= 90.0f) {
+                    ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "%.1f", rates.utilization);
+                } else {
+                    ImGui::Text("%.1f", rates.utilization);
+                }
+                ImGui::TableSetColumnIndex(8);
+                ImGui::Text("%.2f", rates.await_ms);
+                if (ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("read %.2f ms, write %.2f ms", rates.read_await_ms, rates.write_await_ms);
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+    
+    auto selected = disk_graphs.find(selected_disk);
+    if (selected == disk_graphs.end()) {
+        ImGui::TextDisabled("Select a device to see its history");
+        return;
+    }
+    ImGui::Text("%s, last %zu seconds", selected->first.c_str(), selected->second.read_history.values.size());
+    if (ImGui::BeginTable("DiskGraphs", 3)) {
+        renderDiskGraph("read", selected->second.read_history, "Read", true);
+        renderDiskGraph("write", selected->second.write_history, "Write", true);
+        renderDiskGraph("util", selected->second.util_history, "Util", false);
+        ImGui::EndTable();
+    }
+}
+
+// Every real mounted filesystem, from the filesystem monitor
+static void renderFilesystems() {
+    std::vector<MountInfo> filesystems;
+    getFilesystems(filesystems);
+    if (filesystems.empty()) {
+        ImGui::TextDisabled("No filesystems found");
+        return;
+    }
     
-    // Update memory and process info every 2 seconds
-    if (elapsed.count() >= 2) {
-        mem_info = getMemoryInfo();
-        processes = getProcesses();
-        last_mem_update = now;
+    if (ImGui::BeginTable("Filesystems", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Mount", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+        ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Device", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+        ImGui::TableSetupColumn("Usage", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Inodes %", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Growth/s", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableHeadersRow();
+        
+        for (const MountInfo& fs : filesystems) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s", fs.mount_point.c_str());
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", fs.fs_type.c_str());
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%s", fs.device.c_str());
+            ImGui::TableSetColumnIndex(3);
+            if (!fs.has_usage) {
+                ImGui::TextDisabled(fs.stale ? "not responding" : "reading...");
+                continue;
+            }
+            // Used plus available can be less than the size: the rest is reserved for root
+            unsigned long usable = fs.used_kb + fs.free_kb;
+            float used = usable > 0 ? (float)fs.used_kb / usable : 0.0f;
+            std::string overlay = formatBytes(fs.used_kb * 1024) + " / " + formatBytes(usable * 1024);
+            if (fs.stale) overlay += " (stale)";
+            ImGui::ProgressBar(used, ImVec2(-1.0f, 0.0f), overlay.c_str());
+            ImGui::TableSetColumnIndex(4);
+            if (fs.inodes_total > 0) {
+                ImGui::Text("%.1f", 100.0f * (fs.inodes_total - fs.inodes_free) / fs.inodes_total);
+            } else {
+                ImGui::TextDisabled("-");
+            }
+            ImGui::TableSetColumnIndex(5);
+            float growth = fs.growth_kb_per_second;
+            ImGui::Text("%s%s", growth < 0.0f ? "-" : "", formatBytes((unsigned long)((growth < 0.0f ? -growth : growth) * 1024.0f)).c_str());
+        }
+        ImGui::EndTable();
+    }
+}
+
+// Per-node memory and CPU, plus where the selected processes' memory lives.
+// numa_maps is only read while this section is open.
+static void renderNumaPlacement(const std::vector<ProcessInfo>& processes) {
+    if (!ImGui::CollapsingHeader("NUMA Placement")) {
+        requestProcessNuma(std::vector<int>());
+        return;
+    }
+    if (numa_nodes.empty()) {
+        ImGui::Text("No NUMA topology found");
+        return;
+    }
+    
+    if (ImGui::BeginTable("NumaNodes", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Node", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableSetupColumn("CPUs", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableSetupColumn("CPU %", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Anon / File", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+        ImGui::TableSetupColumn("Miss/s", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+        ImGui::TableSetupColumn("Other node/s", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableHeadersRow();
+        
+        for (const NumaNode& node : numa_nodes) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%d", node.id);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%zu", node.cpus.size());
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.1f", node.cpu.usage_percent);
+            ImGui::TableSetColumnIndex(3);
+            float used = node.total_ram > 0 ? (float)node.used_ram / node.total_ram : 0.0f;
+            ImGui::ProgressBar(used, ImVec2(-1.0f, 0.0f), (formatBytes(node.used_ram * 1024) + " / " + formatBytes(node.total_ram * 1024)).c_str());
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%s / %s", formatBytes(node.anon_pages * 1024).c_str(), formatBytes(node.file_pages * 1024).c_str());
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%.0f", node.numa_miss_rate);
+            ImGui::TableSetColumnIndex(6);
+            ImGui::Text("%.0f", node.other_node_rate);
+        }
+        ImGui::EndTable();
+    }
+    
+    // Selected processes, read in the background
+    requestProcessNuma(selected_processes);
+    if (selected_processes.empty()) {
+        ImGui::TextDisabled("Select processes above to see where their memory lives");
+        return;
+    }
+    
+    if (ImGui::BeginTable("ProcessNuma", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+        ImGui::TableSetupColumn("Home node", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Memory per node", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Remote %", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableHeadersRow();
+        
+        for (int pid : selected_processes) {
+            auto proc = std::find_if(processes.begin(), processes.end(), [pid](const ProcessInfo& p) { return p.pid == pid; });
+            ProcessNuma placement;
+            bool known = getProcessNuma(pid, placement);
+            
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%d", pid);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", proc != processes.end() ? proc->name.c_str() : "");
+            ImGui::TableSetColumnIndex(2);
+            if (!known) {
+                ImGui::TextDisabled("reading...");
+                continue;
+            }
+            if (!placement.available) {
+                ImGui::TextDisabled("unavailable");
+                continue;
+            }
+            ImGui::Text("%d", placement.home_node);
+            ImGui::TableSetColumnIndex(3);
+            std::string per_node;
+            for (const auto& entry : placement.node_kb) {
+                if (!per_node.empty()) per_node += "  ";
+                per_node += "N" + std::to_string(entry.first) + ": " + formatBytes(entry.second * 1024);
+            }
+            ImGui::Text("%s", per_node.c_str());
+            ImGui::TableSetColumnIndex(4);
+            if (placement.remote_percent >= 50.0f) {
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "%.1f", placement.remote_percent);
+            } else {
+                ImGui::Text("%.1f", placement.remote_percent);
+            }
+        }
+        ImGui::EndTable();
     }
+}
+
+void renderMemoryAndProcessMonitor() {
+    // Remote hosts only stream their top processes
+    const RemoteHost* remote = viewedRemoteHost();
+    const MemoryInfo& mem_info = remote ? remote->snapshot.memory : local_mem_info;
+    const std::vector<ProcessInfo>& processes = remote ? remote->snapshot.top_processes : local_processes;
     
     ImGui::Text("Memory Usage");
     ImGui::Separator();
@@ -162,6 +1120,7 @@ void renderMemoryAndProcessMonitor() {
     float ram_percent = (float)mem_info.used_ram / mem_info.total_ram;
     ImGui::ProgressBar(ram_percent, ImVec2(0.0f, 0.0f), 
                       (formatBytes(mem_info.used_ram * 1024) + " / " + formatBytes(mem_info.total_ram * 1024)).c_str());
+    renderMemoryBreakdown(mem_info);
     
     // SWAP Usage
     ImGui::Text("Virtual Memory (SWAP):");
@@ -169,11 +1128,21 @@ void renderMemoryAndProcessMonitor() {
     ImGui::ProgressBar(swap_percent, ImVec2(0.0f, 0.0f), 
                       (formatBytes(mem_info.used_swap * 1024) + " / " + formatBytes(mem_info.total_swap * 1024)).c_str());
     
-    // Disk Usage
+    // Disk Usage; remote hosts only stream their root filesystem
     ImGui::Text("Disk Usage:");
-    float disk_percent = (float)mem_info.used_disk / mem_info.total_disk;
-    ImGui::ProgressBar(disk_percent, ImVec2(0.0f, 0.0f), 
-                      (formatBytes(mem_info.used_disk * 1024) + " / " + formatBytes(mem_info.total_disk * 1024)).c_str());
+    if (remote) {
+        float disk_percent = mem_info.total_disk > 0 ? (float)mem_info.used_disk / mem_info.total_disk : 0.0f;
+        ImGui::ProgressBar(disk_percent, ImVec2(0.0f, 0.0f), 
+                          (formatBytes(mem_info.used_disk * 1024) + " / " + formatBytes(mem_info.total_disk * 1024)).c_str());
+    } else {
+        renderFilesystems();
+    }
+    
+    if (!remote) {
+        ImGui::Spacing();
+        renderDiskActivity();
+        renderVmActivity();
+    }
     
     ImGui::Spacing();
     ImGui::Separator();
@@ -191,17 +1160,48 @@ void renderMemoryAndProcessMonitor() {
     }
     
     // Process table
-    if (ImGui::BeginTable("ProcessTable", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | 
+    if (ImGui::BeginTable("ProcessTable", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | 
                          ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY, ImVec2(0, 300))) {
         
         ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed, 80.0f);
         ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
         ImGui::TableSetupColumn("State", ImGuiTableColumnFlags_WidthFixed, 60.0f);
-        ImGui::TableSetupColumn("CPU %", ImGuiTableColumnFlags_WidthFixed, 80.0f);
-        ImGui::TableSetupColumn("Memory %", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableSetupColumn("CPU %", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort |
+                                ImGuiTableColumnFlags_PreferSortDescending, 80.0f);
+        ImGui::TableSetupColumn("Memory %", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 100.0f);
+        ImGui::TableSetupColumn("Read/s", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 90.0f);
+        ImGui::TableSetupColumn("Write/s", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 90.0f);
+        ImGui::TableSetupColumn("I/O calls/s", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 90.0f);
+        ImGui::TableSetupScrollFreeze(0, 1);
         ImGui::TableHeadersRow();
         
-        for (size_t i = 0; i < processes.size(); i++) {
+        // Rows are drawn through an index so the shared process list stays untouched
+        std::vector<size_t> order(processes.size());
+        std::iota(order.begin(), order.end(), 0);
+        const ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        if (sort_specs && sort_specs->SpecsCount > 0) {
+            const ImGuiTableColumnSortSpecs& spec = sort_specs->Specs[0];
+            auto key = [&](const ProcessInfo& p) -> double {
+                switch (spec.ColumnIndex) {
+                    case 0: return p.pid;
+                    case 4: return p.memory_usage;
+                    case 5: return p.io_known ? p.io_read_rate : -1.0;
+                    case 6: return p.io_known ? p.io_write_rate : -1.0;
+                    case 7: return p.io_known ? p.io_syscall_rate : -1.0;
+                    default: return p.cpu_usage;
+                }
+            };
+            bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+            std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+                const ProcessInfo& pa = processes[a];
+                const ProcessInfo& pb = processes[b];
+                if (spec.ColumnIndex == 1) return ascending ? pa.name < pb.name : pa.name > pb.name;
+                if (spec.ColumnIndex == 2) return ascending ? pa.state < pb.state : pa.state > pb.state;
+                return ascending ? key(pa) < key(pb) : key(pa) > key(pb);
+            });
+        }
+        
+        for (size_t i : order) {
             const ProcessInfo& proc = processes[i];
             
             // Apply filter
@@ -249,32 +1249,599 @@ void renderMemoryAndProcessMonitor() {
             
             ImGui::TableSetColumnIndex(4);
             ImGui::Text("%.1f", proc.memory_usage);
+            
+            // Processes we may not trace have no I/O accounting
+            if (!proc.io_known) {
+                for (int column = 5; column <= 7; column++) {
+                    ImGui::TableSetColumnIndex(column);
+                    ImGui::TextDisabled("-");
+                }
+                continue;
+            }
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%s", formatBytes((unsigned long)proc.io_read_rate).c_str());
+            ImGui::TableSetColumnIndex(6);
+            ImGui::Text("%s", formatBytes((unsigned long)proc.io_write_rate).c_str());
+            ImGui::TableSetColumnIndex(7);
+            ImGui::Text("%.0f", proc.io_syscall_rate);
         }
         
         ImGui::EndTable();
     }
+    
+    if (!remote) {
+        renderNumaPlacement(processes);
+    }
 }
 
-void renderNetworkMonitor() {
-    static std::vector<NetworkInterface> interfaces;
-    static auto last_net_update = std::chrono::steady_clock::now();
+// Interface name or address filter and the selected group, shared by every network table
+static std::string interface_filter;
+static std::string interface_group_filter;
+
+static std::vector<const NetworkInterface*> visibleInterfaces(const std::vector<NetworkInterface>& interfaces) {
+    std::string filter_lower = interface_filter;
+    std::transform(filter_lower.begin(), filter_lower.end(), filter_lower.begin(), ::tolower);
     
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - last_net_update);
+    std::vector<const NetworkInterface*> rows;
+    rows.reserve(interfaces.size());
+    for (const NetworkInterface& iface : interfaces) {
+        if (!interface_group_filter.empty() && iface.group != interface_group_filter) continue;
+        if (!filter_lower.empty()) {
+            std::string text = iface.name + " " + iface.ipv4_address + " " + iface.ipv6_address;
+            std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+            if (text.find(filter_lower) == std::string::npos) continue;
+        }
+        rows.push_back(&iface);
+    }
+    return rows;
+}
+
+// The tables share their first columns: name, group, bytes/s, packets/s, errors/s, drops/s, bytes
+static void sortInterfaceRows(std::vector<const NetworkInterface*>& rows, bool receive) {
+    const ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+    if (!sort_specs || sort_specs->SpecsCount == 0) return;
+    
+    const ImGuiTableColumnSortSpecs& spec = sort_specs->Specs[0];
+    bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+    auto key = [&](const NetworkInterface* iface) -> double {
+        switch (spec.ColumnIndex) {
+            case 2: return receive ? iface->rx_bytes_rate : iface->tx_bytes_rate;
+            case 3: return receive ? iface->rx_packets_rate : iface->tx_packets_rate;
+            case 4: return receive ? iface->rx_errs_rate : iface->tx_errs_rate;
+            case 5: return receive ? iface->rx_drop_rate : iface->tx_drop_rate;
+            default: return receive ? iface->rx_bytes : iface->tx_bytes;
+        }
+    };
+    std::stable_sort(rows.begin(), rows.end(), [&](const NetworkInterface* a, const NetworkInterface* b) {
+        if (spec.ColumnIndex == 0) return ascending ? a->name < b->name : a->name > b->name;
+        if (spec.ColumnIndex == 1) return ascending ? a->group < b->group : a->group > b->group;
+        return ascending ? key(a) < key(b) : key(a) > key(b);
+    });
+}
+
+static void setupInterfaceColumns() {
+    ImGui::TableSetupColumn("Interface", ImGuiTableColumnFlags_DefaultSort);
+    ImGui::TableSetupColumn("Group");
+    ImGui::TableSetupColumn("Bytes/s", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Packets/s", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Errors/s", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Drop/s", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_PreferSortDescending);
+}
+
+// Per-direction counters; only the rows in view are built
+static void renderInterfaceTable(const std::vector<NetworkInterface>& interfaces, bool receive) {
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX |
+                            ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable;
+    if (!ImGui::BeginTable(receive ? "RXTable" : "TXTable", 13, flags, ImVec2(0.0f, 400.0f))) return;
+    
+    ImGui::TableSetupScrollFreeze(1, 1);
+    setupInterfaceColumns();
+    const char* extra_columns[] = {"Packets", "Errors", "Drop", "FIFO", receive ? "Frame" : "Colls", receive ? "Multicast" : "Carrier"};
+    for (const char* column : extra_columns) {
+        ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_NoSort);
+    }
+    ImGui::TableHeadersRow();
+    
+    std::vector<const NetworkInterface*> rows = visibleInterfaces(interfaces);
+    sortInterfaceRows(rows, receive);
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rows.size());
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const NetworkInterface& iface = *rows[row];
+            unsigned long counters[] = {
+                receive ? iface.rx_packets : iface.tx_packets, receive ? iface.rx_errs : iface.tx_errs,
+                receive ? iface.rx_drop : iface.tx_drop, receive ? iface.rx_fifo : iface.tx_fifo,
+                receive ? iface.rx_frame : iface.tx_colls, receive ? iface.rx_multicast : iface.tx_carrier,
+            };
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0); ImGui::Text("%s", iface.name.c_str());
+            ImGui::TableSetColumnIndex(1); ImGui::Text("%s", iface.group.c_str());
+            ImGui::TableSetColumnIndex(2); ImGui::Text("%s", formatNetworkBytes((unsigned long)(receive ? iface.rx_bytes_rate : iface.tx_bytes_rate)).c_str());
+            ImGui::TableSetColumnIndex(3); ImGui::Text("%.0f", receive ? iface.rx_packets_rate : iface.tx_packets_rate);
+            ImGui::TableSetColumnIndex(4); ImGui::Text("%.1f", receive ? iface.rx_errs_rate : iface.tx_errs_rate);
+            ImGui::TableSetColumnIndex(5); ImGui::Text("%.1f", receive ? iface.rx_drop_rate : iface.tx_drop_rate);
+            ImGui::TableSetColumnIndex(6); ImGui::Text("%s", formatNetworkBytes(receive ? iface.rx_bytes : iface.tx_bytes).c_str());
+            for (int i = 0; i < 6; i++) {
+                ImGui::TableSetColumnIndex(7 + i);
+                ImGui::Text("%lu", counters[i]);
+            }
+        }
+    }
+    ImGui::EndTable();
+}
+
+// One row per interface: the current rate against the link speed, or against the
+// recent peak for links without one; local interfaces also get their history
+static void renderInterfaceUsage(const std::vector<NetworkInterface>& interfaces, bool receive) {
+    bool local = viewedRemoteHost() == nullptr;
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable;
+    if (!ImGui::BeginTable(receive ? "RXUsage" : "TXUsage", 4, flags, ImVec2(0.0f, 400.0f))) return;
+    
+    const float row_height = 40.0f;
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Interface", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort, 160.0f);
+    ImGui::TableSetupColumn("Group", ImGuiTableColumnFlags_WidthFixed, 110.0f);
+    ImGui::TableSetupColumn(receive ? "Receive rate" : "Transmit rate", ImGuiTableColumnFlags_WidthStretch |
+                            ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_NoSort);
+    ImGui::TableHeadersRow();
+    
+    std::vector<const NetworkInterface*> rows = visibleInterfaces(interfaces);
+    sortInterfaceRows(rows, receive);
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rows.size(), row_height);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const NetworkInterface& iface = *rows[row];
+            float rate = receive ? iface.rx_bytes_rate : iface.tx_bytes_rate;
+            auto graph = local ? interface_graphs.find(iface.name) : interface_graphs.end();
+            const HistoryRing* history = graph != interface_graphs.end() ?
+                (receive ? &graph->second.rx_history : &graph->second.tx_history) : nullptr;
+            
+            float capacity = iface.link_speed_mbps * 1000000.0f / 8.0f;
+            float peak = std::max(rate, 1024.0f);
+            if (history) {
+                for (unsigned long long h = historyOldest(*history); h < history->total; h++) {
+                    peak = std::max(peak, historyAt(*history, h));
+                }
+            }
+            if (capacity <= 0.0f) capacity = peak;
+            
+            ImGui::TableNextRow(ImGuiTableRowFlags_None, row_height);
+            ImGui::PushID(iface.name.c_str());
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%s", iface.name.c_str());
+            if (iface.link_speed_mbps > 0) {
+                ImGui::TextDisabled("%d Mb/s link", iface.link_speed_mbps);
+            } else {
+                ImGui::TextDisabled("no link speed");
+            }
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", iface.group.c_str());
+            ImGui::TableSetColumnIndex(2);
+            std::string overlay = formatNetworkBytes((unsigned long)rate) + "/s";
+            ImGui::ProgressBar(std::min(1.0f, rate / capacity), ImVec2(-1.0f, 0.0f), overlay.c_str());
+            ImGui::TableSetColumnIndex(3);
+            if (history && history->total >= 2) {
+                (gpu_plots ? plotHistoryGpu : plotHistory)("rate", *history, historyOldest(*history), history->total, 0.0f,
+                                                           peak * 1.1f, ImVec2(-1.0f, row_height - 6.0f), nullptr);
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::EndTable();
+}
+
+// Totals per group come from the collector; clicking a group filters every table
+static void renderInterfaceGroups(const std::vector<InterfaceGroupStats>& groups) {
+    if (!ImGui::BeginTable("InterfaceGroups", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) return;
+    
+    ImGui::TableSetupColumn("Group", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Interfaces", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("RX/s", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("TX/s", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+    ImGui::TableSetupColumn("Packets/s", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+    ImGui::TableSetupColumn("Errors/s", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableSetupColumn("Drop/s", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+    ImGui::TableHeadersRow();
+    
+    for (const InterfaceGroupStats& group : groups) {
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        bool selected = interface_group_filter == group.name;
+        if (ImGui::Selectable(group.name.c_str(), selected, ImGuiSelectableFlags_SpanAllColumns)) {
+            interface_group_filter = selected ? "" : group.name;
+        }
+        ImGui::TableSetColumnIndex(1); ImGui::Text("%d", group.interfaces);
+        ImGui::TableSetColumnIndex(2); ImGui::Text("%s", formatNetworkBytes((unsigned long)group.rx_bytes_rate).c_str());
+        ImGui::TableSetColumnIndex(3); ImGui::Text("%s", formatNetworkBytes((unsigned long)group.tx_bytes_rate).c_str());
+        ImGui::TableSetColumnIndex(4); ImGui::Text("%.0f", group.rx_packets_rate + group.tx_packets_rate);
+        ImGui::TableSetColumnIndex(5); ImGui::Text("%.1f", group.errs_rate);
+        ImGui::TableSetColumnIndex(6); ImGui::Text("%.1f", group.drop_rate);
+    }
+    ImGui::EndTable();
+}
+
+static void renderInterfaceAddresses(const std::vector<NetworkInterface>& interfaces) {
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable;
+    if (!ImGui::BeginTable("Addresses", 4, flags, ImVec2(0.0f, 400.0f))) return;
+    
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Interface", ImGuiTableColumnFlags_DefaultSort);
+    ImGui::TableSetupColumn("Group");
+    ImGui::TableSetupColumn("IPv4", ImGuiTableColumnFlags_NoSort);
+    ImGui::TableSetupColumn("IPv6", ImGuiTableColumnFlags_NoSort);
+    ImGui::TableHeadersRow();
+    
+    std::vector<const NetworkInterface*> rows = visibleInterfaces(interfaces);
+    sortInterfaceRows(rows, true);
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rows.size());
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const NetworkInterface& iface = *rows[row];
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0); ImGui::Text("%s", iface.name.c_str());
+            ImGui::TableSetColumnIndex(1); ImGui::Text("%s", iface.group.c_str());
+            ImGui::TableSetColumnIndex(2); ImGui::Text("%s", iface.ipv4_address.c_str());
+            ImGui::TableSetColumnIndex(3); ImGui::Text("%s", iface.ipv6_address.c_str());
+        }
+    }
+    ImGui::EndTable();
+}
+
+static void renderProtocolCounters() {
+    if (!ImGui::CollapsingHeader("Protocol Counters")) return;
+    
+    const ProtocolRates& rates = protocol_rates;
+    ImVec4 warning(1.0f, 0.4f, 0.3f, 1.0f);
+    ImGui::Text("TCP: %llu established, %lu in use, %lu TIME_WAIT, %lu orphaned, %s buffers",
+                protocol_stats.tcp_curr_estab, protocol_stats.tcp_in_use, protocol_stats.tcp_time_wait,
+                protocol_stats.tcp_orphans, formatBytes(protocol_stats.tcp_mem_pages * getpagesize()).c_str());
+    ImGui::Text("Segments: %.0f in/s, %.0f out/s   Opens: %.1f active/s, %.1f passive/s, %.1f failed/s",
+                rates.tcp_in_segs, rates.tcp_out_segs, rates.tcp_active_opens, rates.tcp_passive_opens, rates.tcp_attempt_fails);
+    if (rates.retransmit_percent >= 1.0f) {
+        ImGui::TextColored(warning, "Retransmitting %.1f%% of segments sent", rates.retransmit_percent);
+    } else {
+        ImGui::Text("Retransmitted: %.2f%% of segments sent", rates.retransmit_percent);
+    }
+    ImGui::Text("Retransmits: %.1f fast/s, %.1f SYN/s, %.1f lost again/s   Aborts: %.1f on timeout/s, %.1f on memory/s",
+                rates.tcp_fast_retrans, rates.tcp_syn_retrans, rates.tcp_lost_retransmit, rates.tcp_abort_on_timeout,
+                rates.tcp_abort_on_memory);
+    // A full accept queue means the application is not calling accept() fast enough
+    if (rates.listen_overflows > 0.0f || rates.syncookies_sent > 0.0f) {
+        ImGui::TextColored(warning, "Accept queues overflowing: %.1f/s, SYN cookies sent %.1f/s", rates.listen_overflows,
+                           rates.syncookies_sent);
+    }
+    ImGui::Text("UDP: %lu in use, %.0f in/s, %.0f out/s, %.1f to closed ports/s, %.1f send buffer errors/s",
+                protocol_stats.udp_in_use, rates.udp_in_datagrams, rates.udp_out_datagrams, rates.udp_no_ports,
+                rates.udp_sndbuf_errors);
+    
+    if (ImGui::BeginTable("ProtocolGraphs", 2)) {
+        for (int i = 0; i < PROTOCOL_GRAPH_COUNT; i++) {
+            const ProtocolGraph& graph = protocol_graphs[i];
+            unsigned long long end = graph.history.total;
+            unsigned long long begin = std::max(historyOldest(graph.history), end > 300 ? end - 300 : 0);
+            float peak = 1.0f;
+            for (unsigned long long h = begin; h < end; h++) {
+                peak = std::max(peak, historyAt(graph.history, h));
+            }
+            
+            char overlay[64];
+            snprintf(overlay, sizeof(overlay), "%s %.1f (peak %.0f)", graph.label, protocol_rates.*graph.rate, peak);
+            ImGui::TableNextColumn();
+            ImGui::PushID(i);
+            (gpu_plots ? plotHistoryGpu : plotHistory)("protocol", graph.history, begin, end, 0.0f, peak * 1.1f,
+                                                       ImVec2(-1.0f, 60.0f), overlay);
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+}
+
+// Connection filters: free text, a TCP state (-1 for any) and a protocol
+static std::string connection_filter;
+static int connection_state_filter = -1;
+static int connection_protocol_filter = 0; // 0 all, 1 TCP, 2 UDP, 3 Unix
+
+static bool connectionVisible(const SocketInfo& socket, const std::string& filter_lower) {
+    bool is_unix = socket.family == AF_UNIX;
+    if (connection_protocol_filter == 1 && (is_unix || socket.protocol != IPPROTO_TCP)) return false;
+    if (connection_protocol_filter == 2 && (is_unix || socket.protocol != IPPROTO_UDP)) return false;
+    if (connection_protocol_filter == 3 && !is_unix) return false;
+    if (connection_state_filter >= 0 && (is_unix || socket.protocol != IPPROTO_TCP || socket.state != connection_state_filter)) {
+        return false;
+    }
+    if (filter_lower.empty()) return true;
+    
+    std::string text = formatSocketAddress(socket, false) + " " + formatSocketAddress(socket, true) + " " +
+                       socket.process + " " + std::to_string(socket.pid);
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return text.find(filter_lower) != std::string::npos;
+}
+
+static int compareEndpoints(const SocketInfo& a, const SocketInfo& b, bool remote) {
+    if (a.family != b.family) return a.family < b.family ? -1 : 1;
+    if (a.family == AF_UNIX) return a.unix_path.compare(b.unix_path);
+    int order = memcmp(remote ? a.remote_address : a.local_address, remote ? b.remote_address : b.local_address, 16);
+    if (order != 0) return order;
+    unsigned short port_a = remote ? a.remote_port : a.local_port;
+    unsigned short port_b = remote ? b.remote_port : b.local_port;
+    return port_a == port_b ? 0 : port_a < port_b ? -1 : 1;
+}
+
+// Row order is rebuilt only when a dump, the filters or the sort change, so a
+// table of hundreds of thousands of sockets costs only its visible rows per frame
+static void updateConnectionRows(std::vector<int>& rows, const ImGuiTableSortSpecs* sort_specs) {
+    std::string filter_lower = connection_filter;
+    std::transform(filter_lower.begin(), filter_lower.end(), filter_lower.begin(), ::tolower);
+    rows.clear();
+    for (int i = 0; i < (int)local_sockets.size(); i++) {
+        if (connectionVisible(local_sockets[i], filter_lower)) rows.push_back(i);
+    }
+    if (!sort_specs || sort_specs->SpecsCount == 0) return;
+    
+    const ImGuiTableColumnSortSpecs& spec = sort_specs->Specs[0];
+    bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+    auto compare = [&](const SocketInfo& a, const SocketInfo& b) -> double {
+        switch (spec.ColumnIndex) {
+            case 0: return strcmp(socketProtocolName(a), socketProtocolName(b));
+            case 1: return strcmp(socketStateName(a), socketStateName(b));
+            case 2: return compareEndpoints(a, b, false);
+            case 3: return compareEndpoints(a, b, true);
+            case 4: return (double)a.rx_queue - b.rx_queue;
+            case 5: return (double)a.tx_queue - b.tx_queue;
+            case 6: return a.rtt_ms - b.rtt_ms;
+            case 7: return (double)a.cwnd - b.cwnd;
+            case 8: return (double)a.retransmits - b.retransmits;
+            case 9: return a.pid - b.pid;
+            default: return a.process.compare(b.process);
+        }
+    };
+    std::stable_sort(rows.begin(), rows.end(), [&](int a, int b) {
+        double order = compare(local_sockets[a], local_sockets[b]);
+        return ascending ? order < 0 : order > 0;
+    });
+}
+
+static void renderConnections() {
+    if (viewedRemoteHost()) {
+        ImGui::TextDisabled("Connections are listed for the local machine only.");
+        return;
+    }
+    connections_shown = true;
+    if (socket_generation == 0) {
+        ImGui::TextDisabled("Collecting sockets...");
+        return;
+    }
+    
+    // Per-state counts; clicking a state filters the table to it
+    const SocketSummary& summary = local_socket_summary;
+    ImGui::Text("TCP:");
+    for (int state = 0; state < SOCKET_TCP_STATES; state++) {
+        if (summary.tcp_states[state] == 0) continue;
+        ImGui::SameLine();
+        char label[64];
+        snprintf(label, sizeof(label), "%s %d", tcpStateName(state), summary.tcp_states[state]);
+        if (ImGui::Selectable(label, connection_state_filter == state, 0, ImGui::CalcTextSize(label))) {
+            connection_state_filter = connection_state_filter == state ? -1 : state;
+        }
+    }
+    ImGui::Text("UDP: %d   Unix: %d", summary.udp_sockets, summary.unix_sockets);
+    if (summary.unowned > 0) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%d sockets belong to processes we cannot inspect)", summary.unowned);
+    }
+    
+    char filter_buffer[128];
+    strncpy(filter_buffer, connection_filter.c_str(), sizeof(filter_buffer) - 1);
+    filter_buffer[sizeof(filter_buffer) - 1] = '\0';
+    ImGui::SetNextItemWidth(300.0f);
+    if (ImGui::InputText("Filter address, port or process", filter_buffer, sizeof(filter_buffer))) {
+        connection_filter = filter_buffer;
+    }
+    ImGui::SameLine();
+    const char* protocols[] = {"All", "TCP", "UDP", "Unix"};
+    ImGui::SetNextItemWidth(80.0f);
+    ImGui::Combo("Protocol", &connection_protocol_filter, protocols, IM_ARRAYSIZE(protocols));
+    
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX |
+                            ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable;
+    if (!ImGui::BeginTable("Connections", 11, flags, ImVec2(0.0f, 400.0f))) return;
+    
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Proto");
+    ImGui::TableSetupColumn("State");
+    ImGui::TableSetupColumn("Local", ImGuiTableColumnFlags_DefaultSort);
+    ImGui::TableSetupColumn("Remote");
+    ImGui::TableSetupColumn("Recv-Q", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Send-Q", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("RTT ms", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Cwnd", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("Retrans", ImGuiTableColumnFlags_PreferSortDescending);
+    ImGui::TableSetupColumn("PID");
+    ImGui::TableSetupColumn("Process");
+    ImGui::TableHeadersRow();
+    
+    static std::vector<int> rows;
+    static unsigned long long rows_generation = 0;
+    static std::string rows_filter;
+    static int rows_state = -1;
+    static int rows_protocol = 0;
+    ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+    if (rows_generation != socket_generation || rows_filter != connection_filter || rows_state != connection_state_filter ||
+        rows_protocol != connection_protocol_filter || (sort_specs && sort_specs->SpecsDirty)) {
+        updateConnectionRows(rows, sort_specs);
+        rows_generation = socket_generation;
+        rows_filter = connection_filter;
+        rows_state = connection_state_filter;
+        rows_protocol = connection_protocol_filter;
+        if (sort_specs) sort_specs->SpecsDirty = false;
+    }
+    
+    ImGuiListClipper clipper;
+    clipper.Begin((int)rows.size());
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            const SocketInfo& socket = local_sockets[rows[row]];
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0); ImGui::Text("%s", socketProtocolName(socket));
+            ImGui::TableSetColumnIndex(1); ImGui::Text("%s", socketStateName(socket));
+            ImGui::TableSetColumnIndex(2); ImGui::Text("%s", formatSocketAddress(socket, false).c_str());
+            ImGui::TableSetColumnIndex(3); ImGui::Text("%s", formatSocketAddress(socket, true).c_str());
+            ImGui::TableSetColumnIndex(4); ImGui::Text("%u", socket.rx_queue);
+            ImGui::TableSetColumnIndex(5); ImGui::Text("%u", socket.tx_queue);
+            if (socket.has_tcp_info) {
+                ImGui::TableSetColumnIndex(6); ImGui::Text("%.2f", socket.rtt_ms);
+                if (ImGui::IsItemHovered()) ImGui::SetTooltip("variance %.2f ms", socket.rtt_var_ms);
+                ImGui::TableSetColumnIndex(7); ImGui::Text("%u", socket.cwnd);
+                ImGui::TableSetColumnIndex(8); ImGui::Text("%u", socket.retransmits);
+            }
+            if (socket.pid >= 0) {
+                ImGui::TableSetColumnIndex(9); ImGui::Text("%d", socket.pid);
+                ImGui::TableSetColumnIndex(10); ImGui::Text("%s", socket.process.c_str());
+            }
+        }
+    }
+    ImGui::EndTable();
+}
+
+// Bytes per second per process and cgroup from TCP socket counters
+static void renderProcessTraffic() {
+    if (viewedRemoteHost()) {
+        ImGui::TextDisabled("Process traffic is measured on the local machine only.");
+        return;
+    }
+    connections_shown = true;
+    if (socket_generation < 2) {
+        ImGui::TextDisabled("Measuring socket traffic...");
+        return;
+    }
+    ImGui::TextDisabled("TCP only: UDP sockets carry no byte counters.");
+    
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY |
+                            ImGuiTableFlags_Sortable | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("ProcessTraffic", 6, flags, ImVec2(0.0f, 300.0f))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("PID");
+        ImGui::TableSetupColumn("Process");
+        ImGui::TableSetupColumn("Cgroup");
+        ImGui::TableSetupColumn("TCP sockets", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("RX/s", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("TX/s", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableHeadersRow();
+        
+        std::vector<const ProcessNetwork*> rows;
+        for (const ProcessNetwork& process : local_process_network) rows.push_back(&process);
+        const ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        if (sort_specs && sort_specs->SpecsCount > 0) {
+            const ImGuiTableColumnSortSpecs& spec = sort_specs->Specs[0];
+            bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+            auto key = [&](const ProcessNetwork* process) -> double {
+                switch (spec.ColumnIndex) {
+                    case 0: return process->pid;
+                    case 3: return process->sockets;
+                    case 4: return process->rx_rate;
+                    default: return process->tx_rate;
+                }
+            };
+            std::stable_sort(rows.begin(), rows.end(), [&](const ProcessNetwork* a, const ProcessNetwork* b) {
+                if (spec.ColumnIndex == 1) return ascending ? a->name < b->name : a->name > b->name;
+                if (spec.ColumnIndex == 2) return ascending ? a->cgroup < b->cgroup : a->cgroup > b->cgroup;
+                return ascending ? key(a) < key(b) : key(a) > key(b);
+            });
+        }
+        
+        ImGuiListClipper clipper;
+        clipper.Begin((int)rows.size());
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const ProcessNetwork& process = *rows[row];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                if (process.pid >= 0) ImGui::Text("%d", process.pid);
+                ImGui::TableSetColumnIndex(1);
+                if (process.pid >= 0) {
+                    ImGui::Text("%s", process.name.c_str());
+                } else {
+                    ImGui::TextDisabled("(no visible owner)");
+                }
+                ImGui::TableSetColumnIndex(2); ImGui::Text("%s", process.cgroup.c_str());
+                ImGui::TableSetColumnIndex(3); ImGui::Text("%d", process.sockets);
+                ImGui::TableSetColumnIndex(4); ImGui::Text("%s", formatNetworkBytes((unsigned long)process.rx_rate).c_str());
+                ImGui::TableSetColumnIndex(5); ImGui::Text("%s", formatNetworkBytes((unsigned long)process.tx_rate).c_str());
+            }
+        }
+        ImGui::EndTable();
+    }
     
-    // Update network info every 2 seconds
-    if (elapsed.count() >= 2) {
-        interfaces = getNetworkInfo();
-        last_net_update = now;
+    ImGui::Text("By cgroup:");
+    if (ImGui::BeginTable("CgroupTraffic", 4, flags, ImVec2(0.0f, 200.0f))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Cgroup", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Processes", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("RX/s", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableSetupColumn("TX/s", ImGuiTableColumnFlags_PreferSortDescending);
+        ImGui::TableHeadersRow();
+        
+        std::vector<const CgroupNetwork*> rows;
+        for (const CgroupNetwork& cgroup : local_cgroup_network) rows.push_back(&cgroup);
+        const ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs();
+        if (sort_specs && sort_specs->SpecsCount > 0) {
+            const ImGuiTableColumnSortSpecs& spec = sort_specs->Specs[0];
+            bool ascending = spec.SortDirection == ImGuiSortDirection_Ascending;
+            auto key = [&](const CgroupNetwork* cgroup) -> double {
+                switch (spec.ColumnIndex) {
+                    case 1: return cgroup->processes;
+                    case 2: return cgroup->rx_rate;
+                    default: return cgroup->tx_rate;
+                }
+            };
+            std::stable_sort(rows.begin(), rows.end(), [&](const CgroupNetwork* a, const CgroupNetwork* b) {
+                if (spec.ColumnIndex == 0) return ascending ? a->cgroup < b->cgroup : a->cgroup > b->cgroup;
+                return ascending ? key(a) < key(b) : key(a) > key(b);
+            });
+        }
+        
+        for (const CgroupNetwork* cgroup : rows) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0); ImGui::Text("%s", cgroup->cgroup.c_str());
+            ImGui::TableSetColumnIndex(1); ImGui::Text("%d", cgroup->processes);
+            ImGui::TableSetColumnIndex(2); ImGui::Text("%s", formatNetworkBytes((unsigned long)cgroup->rx_rate).c_str());
+            ImGui::TableSetColumnIndex(3); ImGui::Text("%s", formatNetworkBytes((unsigned long)cgroup->tx_rate).c_str());
+        }
+        ImGui::EndTable();
     }
+}
+
+void renderNetworkMonitor() {
+    const RemoteHost* remote = viewedRemoteHost();
+    const std::vector<NetworkInterface>& interfaces = remote ? remote->snapshot.interfaces : local_interfaces;
+    const std::vector<InterfaceGroupStats>& groups = remote ? remote->interface_groups : local_interface_groups;
     
     ImGui::Text("Network Information");
     ImGui::Separator();
     
-    // Display network interfaces and their IPv4 addresses
-    ImGui::Text("Network Interfaces:");
-    for (const auto& iface : interfaces) {
-        ImGui::Text("%s: %s", iface.name.c_str(), iface.ipv4_address.c_str());
+    ImGui::Text("Interface groups (%zu interfaces):", interfaces.size());
+    renderInterfaceGroups(groups);
+    if (!remote) {
+        renderProtocolCounters();
+    }
+    
+    // Filter input
+    char filter_buffer[128];
+    strncpy(filter_buffer, interface_filter.c_str(), sizeof(filter_buffer) - 1);
+    filter_buffer[sizeof(filter_buffer) - 1] = '\0';
+    if (ImGui::InputText("Filter interfaces", filter_buffer, sizeof(filter_buffer))) {
+        interface_filter = filter_buffer;
+    }
+    if (!interface_group_filter.empty()) {
+        ImGui::SameLine();
+        if (ImGui::SmallButton(("Group: " + interface_group_filter + " (clear)").c_str())) {
+            interface_group_filter.clear();
+        }
     }
     
     ImGui::Spacing();
@@ -282,98 +1849,34 @@ void renderNetworkMonitor() {
     
     // Network statistics tables
     if (ImGui::BeginTabBar("NetworkTabBar")) {
-        
-        // RX Table
         if (ImGui::BeginTabItem("RX (Receive)")) {
-            if (ImGui::BeginTable("RXTable", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX)) {
-                ImGui::TableSetupColumn("Interface");
-                ImGui::TableSetupColumn("Bytes");
-                ImGui::TableSetupColumn("Packets");
-                ImGui::TableSetupColumn("Errors");
-                ImGui::TableSetupColumn("Drop");
-                ImGui::TableSetupColumn("FIFO");
-                ImGui::TableSetupColumn("Frame");
-                ImGui::TableSetupColumn("Compressed");
-                ImGui::TableSetupColumn("Multicast");
-                ImGui::TableHeadersRow();
-                
-                for (const auto& iface : interfaces) {
-                    ImGui::TableNextRow();
-                    ImGui::TableSetColumnIndex(0); ImGui::Text("%s", iface.name.c_str());
-                    ImGui::TableSetColumnIndex(1); ImGui::Text("%lu", iface.rx_bytes);
-                    ImGui::TableSetColumnIndex(2); ImGui::Text("%lu", iface.rx_packets);
-                    ImGui::TableSetColumnIndex(3); ImGui::Text("%lu", iface.rx_errs);
-                    ImGui::TableSetColumnIndex(4); ImGui::Text("%lu", iface.rx_drop);
-                    ImGui::TableSetColumnIndex(5); ImGui::Text("%lu", iface.rx_fifo);
-                    ImGui::TableSetColumnIndex(6); ImGui::Text("%lu", iface.rx_frame);
-                    ImGui::TableSetColumnIndex(7); ImGui::Text("%lu", iface.rx_compressed);
-                    ImGui::TableSetColumnIndex(8); ImGui::Text("%lu", iface.rx_multicast);
-                }
-                ImGui::EndTable();
-            }
+            renderInterfaceTable(interfaces, true);
             ImGui::EndTabItem();
         }
-        
-        // TX Table
         if (ImGui::BeginTabItem("TX (Transmit)")) {
-            if (ImGui::BeginTable("TXTable", 9, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollX)) {
-                ImGui::TableSetupColumn("Interface");
-                ImGui::TableSetupColumn("Bytes");
-                ImGui::TableSetupColumn("Packets");
-                ImGui::TableSetupColumn("Errors");
-                ImGui::TableSetupColumn("Drop");
-                ImGui::TableSetupColumn("FIFO");
-                ImGui::TableSetupColumn("Colls");
-                ImGui::TableSetupColumn("Carrier");
-                ImGui::TableSetupColumn("Compressed");
-                ImGui::TableHeadersRow();
-                
-                for (const auto& iface : interfaces) {
-                    ImGui::TableNextRow();
-                    ImGui::TableSetColumnIndex(0); ImGui::Text("%s", iface.name.c_str());
-                    ImGui::TableSetColumnIndex(1); ImGui::Text("%lu", iface.tx_bytes);
-                    ImGui::TableSetColumnIndex(2); ImGui::Text("%lu", iface.tx_packets);
-                    ImGui::TableSetColumnIndex(3); ImGui::Text("%lu", iface.tx_errs);
-                    ImGui::TableSetColumnIndex(4); ImGui::Text("%lu", iface.tx_drop);
-                    ImGui::TableSetColumnIndex(5); ImGui::Text("%lu", iface.tx_fifo);
-                    ImGui::TableSetColumnIndex(6); ImGui::Text("%lu", iface.tx_colls);
-                    ImGui::TableSetColumnIndex(7); ImGui::Text("%lu", iface.tx_carrier);
-                    ImGui::TableSetColumnIndex(8); ImGui::Text("%lu", iface.tx_compressed);
-                }
-                ImGui::EndTable();
-            }
+            renderInterfaceTable(interfaces, false);
             ImGui::EndTabItem();
         }
         
-        // RX Visual Usage
+        // Current rates against link speed
         if (ImGui::BeginTabItem("RX Usage")) {
-            ImGui::Text("Network RX Usage (0GB - 2GB scale):");
-            for (const auto& iface : interfaces) {
-                double gb_value = iface.rx_bytes / (1024.0 * 1024.0 * 1024.0);
-                float progress = std::min(1.0f, (float)(gb_value / 2.0)); // Scale to 2GB max
-                
-                std::string formatted = formatNetworkBytes(iface.rx_bytes);
-                if (!formatted.empty()) {
-                    ImGui::Text("%s:", iface.name.c_str());
-                    ImGui::ProgressBar(progress, ImVec2(0.0f, 0.0f), formatted.c_str());
-                }
-            }
+            renderInterfaceUsage(interfaces, true);
             ImGui::EndTabItem();
         }
-        
-        // TX Visual Usage
         if (ImGui::BeginTabItem("TX Usage")) {
-            ImGui::Text("Network TX Usage (0GB - 2GB scale):");
-            for (const auto& iface : interfaces) {
-                double gb_value = iface.tx_bytes / (1024.0 * 1024.0 * 1024.0);
-                float progress = std::min(1.0f, (float)(gb_value / 2.0)); // Scale to 2GB max
-                
-                std::string formatted = formatNetworkBytes(iface.tx_bytes);
-                if (!formatted.empty()) {
-                    ImGui::Text("%s:", iface.name.c_str());
-                    ImGui::ProgressBar(progress, ImVec2(0.0f, 0.0f), formatted.c_str());
-                }
-            }
+            renderInterfaceUsage(interfaces, false);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Addresses")) {
+            renderInterfaceAddresses(interfaces);
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Connections")) {
+            renderConnections();
+            ImGui::EndTabItem();
+        }
+        if (ImGui::BeginTabItem("Process Traffic")) {
+            renderProcessTraffic();
             ImGui::EndTabItem();
         }
         
@@ -381,7 +1884,208 @@ void renderNetworkMonitor() {
     }
 }
 
+void renderHostGrid() {
+    ImGui::Text("Remote Hosts");
+    ImGui::Separator();
+    ImGui::TextWrapped("Select a host to show it in the System, Memory & Processes and Network tabs.");
+    
+    if (ImGui::BeginTable("HostTable", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+        ImGui::TableSetupColumn("Host", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+        ImGui::TableSetupColumn("Memory", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+        ImGui::TableSetupColumn("Temp", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("Procs", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+        ImGui::TableSetupColumn("CPU History", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+        ImGui::TableSetupColumn("Received", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+        ImGui::TableHeadersRow();
+        
+        for (size_t i = 0; i < remote_hosts.size(); i++) {
+            const RemoteHost& host = remote_hosts[i];
+            const MetricsSnapshot& snap = host.snapshot;
+            ImGui::TableNextRow();
+            ImGui::PushID((int)i);
+            
+            ImGui::TableSetColumnIndex(0);
+            std::string label = snap.system.hostname.empty() ? host.address : snap.system.hostname + " (" + host.address + ")";
+            if (ImGui::Selectable(label.c_str(), viewed_host == (int)i, ImGuiSelectableFlags_SpanAllColumns)) {
+                viewed_host = (int)i;
+            }
+            
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%s", host.status.c_str());
+            if (!host.has_snapshot) {
+                ImGui::PopID();
+                continue;
+            }
+            
+            ImGui::TableSetColumnIndex(2);
+            char cpu_text[32];
+            snprintf(cpu_text, sizeof(cpu_text), "%.1f%%", snap.cpu.usage_percent);
+            ImGui::ProgressBar(snap.cpu.usage_percent / 100.0f, ImVec2(-1.0f, 0.0f), cpu_text);
+            
+            ImGui::TableSetColumnIndex(3);
+            float ram_percent = snap.memory.total_ram > 0 ? (float)snap.memory.used_ram / snap.memory.total_ram : 0.0f;
+            char mem_text[32];
+            snprintf(mem_text, sizeof(mem_text), "%.1f%%", ram_percent * 100.0f);
+            ImGui::ProgressBar(ram_percent, ImVec2(-1.0f, 0.0f), mem_text);
+            
+            ImGui::TableSetColumnIndex(4);
+            if (snap.thermal.available) {
+                ImGui::Text("%.1f°C", snap.thermal.temperature);
+            } else {
+                ImGui::TextDisabled("n/a");
+            }
+            
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%d", snap.system.total_processes);
+            
+            ImGui::TableSetColumnIndex(6);
+            unsigned long long end = host.cpu_history.total;
+            (gpu_plots ? plotHistoryGpu : plotHistory)("cpu", host.cpu_history, end > 60 ? end - 60 : 0, end,
+                                                       0.0f, 100.0f, ImVec2(-1.0f, 20.0f), nullptr);
+            
+            ImGui::TableSetColumnIndex(7);
+            ImGui::Text("%s", formatBytes(host.bytes_received).c_str());
+            
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+}
+
+static volatile sig_atomic_t quit_requested = 0;
+
+static void handleQuitSignal(int) {
+    quit_requested = 1;
+}
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --headless               run without a window (requires an exporter)\n"
+              << "  --metrics-port PORT      serve Prometheus metrics on PORT\n"
+              << "  --metrics-address ADDR   address to bind the exporter to (default 127.0.0.1)\n"
+              << "  --agent ADDR             stream snapshots to viewers on host:port or unix:/path\n"
+              << "  --connect ADDR           watch an agent at ADDR, may be repeated\n"
+              << "  --shm NAME               publish snapshots to shared memory (e.g. /system-monitor)\n"
+              << "  --interval SEC           seconds between published snapshots (default 1)\n"
+              << "  --top N                  number of processes per snapshot (default 10)\n"
+              << "  --history-mb N           memory budget for metric history (default 16)\n"
+              << "  --max-fps N              cap on redraws caused by new data (default 30)\n"
+              << "  --unfocused-fps N        redraw rate while the window is unfocused (default 5)\n"
+              << "  --gpu-plots              keep graph history in GPU buffers\n"
+              << "  --gpu-timing             show the GPU cost of each frame\n"
+              << "  --bench-network N        time N refreshes of each network collector and exit\n"
+              << "  --powercap-root DIR      read RAPL zones from DIR instead of /sys/class/powercap\n";
+}
+
 int main(int argc, char* argv[]) {
+    // Parse command line
+    SamplerSettings sampler_settings;
+    MetricsSettings metrics_settings;
+    StreamSettings stream_settings;
+    std::string shm_name;
+    std::vector<std::string> agent_addresses;
+    int max_fps = 30;
+    float history_mb = 16.0f;
+    int unfocused_fps = 5;
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--metrics-port" && has_value) {
+            metrics_settings.port = atoi(argv[++i]);
+        } else if (arg == "--metrics-address" && has_value) {
+            metrics_settings.address = argv[++i];
+        } else if (arg == "--agent" && has_value) {
+            stream_settings.listen = argv[++i];
+        } else if (arg == "--shm" && has_value) {
+            shm_name = argv[++i];
+        } else if (arg == "--interval" && has_value) {
+            sampler_settings.interval_seconds = std::max(0.1f, (float)atof(argv[++i]));
+        } else if (arg == "--top" && has_value) {
+            sampler_settings.top_processes = atoi(argv[++i]);
+        } else if (arg == "--history-mb" && has_value) {
+            history_mb = std::max(0.1f, (float)atof(argv[++i]));
+        } else if (arg == "--max-fps" && has_value) {
+            max_fps = atoi(argv[++i]);
+        } else if (arg == "--unfocused-fps" && has_value) {
+            unfocused_fps = atoi(argv[++i]);
+        } else if (arg == "--gpu-plots") {
+            gpu_plots = true;
+        } else if (arg == "--gpu-timing") {
+            gpu_timing = true;
+        } else if (arg == "--bench-network" && has_value) {
+            benchmarkNetworkInfo(std::max(1, atoi(argv[++i])));
+            return 0;
+        } else if (arg == "--powercap-root" && has_value) {
+            setPowercapRoot(argv[++i]);
+        } else if (arg == "--connect" && has_value) {
+            agent_addresses.push_back(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    bool publishing = metrics_settings.port > 0 || !stream_settings.listen.empty() || !shm_name.empty();
+    if (headless && !publishing) {
+        std::cerr << "Error: --headless needs --metrics-port, --agent or --shm" << std::endl;
+        return 1;
+    }
+
+    // Start the publishers before the GUI so both modes share them
+    if (metrics_settings.port > 0) {
+        if (!startMetricsServer(metrics_settings)) {
+            std::cerr << "Error: could not listen on " << metrics_settings.address << ":" << metrics_settings.port << std::endl;
+            return 1;
+        }
+        std::cerr << "Serving metrics on http://" << metrics_settings.address << ":" << metrics_settings.port << "/metrics" << std::endl;
+    }
+
+    if (!stream_settings.listen.empty()) {
+        if (!startStreamAgent(stream_settings)) {
+            std::cerr << "Error: could not listen on " << stream_settings.listen << std::endl;
+            stopMetricsServer();
+            return 1;
+        }
+        std::cerr << "Streaming snapshots on " << stream_settings.listen << std::endl;
+    }
+
+    if (!shm_name.empty()) {
+        if (!startSharedSnapshot(shm_name)) {
+            std::cerr << "Error: could not create shared memory " << shm_name << std::endl;
+            stopStreamAgent();
+            stopMetricsServer();
+            return 1;
+        }
+        std::cerr << "Publishing snapshots to shared memory " << shm_name << std::endl;
+    }
+
+    // Filesystem usage is probed in the background so a hung mount never stalls sampling
+    startFilesystemMonitor(5.0f);
+
+    // A single sampler feeds every publisher
+    if (publishing) {
+        startSampler(sampler_settings);
+    }
+
+    if (headless) {
+        signal(SIGINT, handleQuitSignal);
+        signal(SIGTERM, handleQuitSignal);
+        while (!quit_requested) {
+            usleep(200 * 1000);
+        }
+        stopSampler();
+        stopSharedSnapshot();
+        stopStreamAgent();
+        stopMetricsServer();
+        stopFilesystemMonitor();
+        return 0;
+    }
+
     // Initialize SDL
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER) != 0) {
         std::cerr << "Error: " << SDL_GetError() << std::endl;
@@ -422,66 +2126,196 @@ int main(int argc, char* argv[]) {
     // Setup Platform/Renderer backends
     ImGui_ImplSDL2_InitForOpenGL(window, gl_context);
     ImGui_ImplOpenGL3_Init(glsl_version);
+    if (gpu_timing && !initGpuTimer()) {
+        std::cerr << "Warning: GPU timing needs OpenGL 3.3 timer queries" << std::endl;
+        gpu_timing = false;
+    }
 
     // Initialize graph settings
-    cpu_graph_settings = {true, 30.0f, 100.0f, 200};
-    fan_graph_settings = {true, 30.0f, 4000.0f, 200};
-    thermal_graph_settings = {true, 30.0f, 100.0f, 200};
+    cpu_graph_settings = {true, 2.0f, 100.0f, 200};
+    fan_graph_settings = {true, 2.0f, 4000.0f, 200};
+    thermal_graph_settings = {true, 2.0f, 100.0f, 200};
+    remote_cpu_graph_settings = cpu_graph_settings;
+    remote_fan_graph_settings = fan_graph_settings;
+    remote_thermal_graph_settings = thermal_graph_settings;
 
-    // Main loop
+    // Split the history budget: remote hosts keep a short fixed window, a quarter
+    // of the rest is shared by per-device rings, local graphs get the remainder
+    size_t history_budget = (size_t)(history_mb * 1024.0f * 1024.0f);
+    size_t remote_bytes = agent_addresses.size() * 3 * REMOTE_HISTORY_POINTS * sizeof(float);
+    size_t local_budget = history_budget > remote_bytes ? history_budget - remote_bytes : 0;
+    device_history_budget = local_budget / 4;
+    size_t local_capacity = historyCapacityForBudget(local_budget - device_history_budget,
+                                                     3 + VM_GRAPH_COUNT + PROTOCOL_GRAPH_COUNT);
+    setHistoryCapacity(cpu_history, local_capacity);
+    setHistoryCapacity(fan_history, local_capacity);
+    setHistoryCapacity(thermal_history, local_capacity);
+    for (VmGraph& graph : vm_graphs) {
+        setHistoryCapacity(graph.history, local_capacity);
+    }
+    for (ProtocolGraph& graph : protocol_graphs) {
+        setHistoryCapacity(graph.history, local_capacity);
+    }
+
+    // Background threads wake the loop through this event
+    redraw_event_type = SDL_RegisterEvents(1);
+    startStreamViewer(agent_addresses);
+
+    // Fill everything once up front so the first frame is complete
+    sampleMemoryAndProcesses();
+    sampleNetwork();
+    sampleSensors(); // picks the headline sensors
+
+    // Local collectors, each on its own interval
+    cpu_graph_settings.task_id = addPeriodicTask(sampleInterval(cpu_graph_settings), sampleCPU);
+    addPeriodicTask(SENSOR_SWEEP_SECONDS, sampleSensors);
+    sensor_task_id = addPeriodicTask(1.0f, sampleHeadlineSensors);
+    fan_graph_settings.task_id = sensor_task_id;
+    thermal_graph_settings.task_id = sensor_task_id;
+    retimeSensorTask();
+    addPeriodicTask(2.0f, sampleMemoryAndProcesses);
+    addPeriodicTask(2.0f, sampleNetwork);
+    addPeriodicTask(1.0f, sampleVmStat);
+    addPeriodicTask(1.0f, sampleDiskStats);
+    addPeriodicTask(1.0f, sampleProtocolStats);
+    addPeriodicTask(1.0f, samplePower);
+    addPeriodicTask(2.0f, sampleNuma);
+    addPeriodicTask(3.0f, sampleConnections);
+
+    // Main loop: sleep until input or new data, and only draw when needed.
+    // Input is answered right away; new data is drawn at most max_fps times a second.
     bool done = false;
+    int input_frames = 2; // ImGui needs a second frame to settle after input
+    bool data_changed = true;
+    auto last_frame = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    int focused_frame_ms = 1000 / std::max(1, max_fps);
+    int unfocused_frame_ms = 1000 / std::max(1, unfocused_fps);
     while (!done) {
+        Uint32 window_state = SDL_GetWindowFlags(window);
+        bool minimized = (window_state & (SDL_WINDOW_MINIMIZED | SDL_WINDOW_HIDDEN)) != 0;
+        bool focused = (window_state & SDL_WINDOW_INPUT_FOCUS) != 0;
+        int frame_ms = focused ? focused_frame_ms : unfocused_frame_ms;
+        int since_last_frame = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - last_frame).count();
+
+        int timeout = 1000;
+        if (!minimized && input_frames > 0) {
+            // Unfocused windows answer input at their own frame rate too
+            timeout = focused ? 0 : std::max(0, unfocused_frame_ms - since_last_frame);
+        } else if (!minimized && data_changed) {
+            timeout = std::max(0, frame_ms - since_last_frame);
+        }
+
         SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            ImGui_ImplSDL2_ProcessEvent(&event);
+        bool have_event = timeout > 0 ? SDL_WaitEventTimeout(&event, timeout) != 0 : SDL_PollEvent(&event) != 0;
+        while (have_event) {
+            if (event.type == redraw_event_type) {
+                redraw_pending = false;
+                data_changed = true;
+            } else {
+                ImGui_ImplSDL2_ProcessEvent(&event);
+                input_frames = 2;
+            }
             if (event.type == SDL_QUIT)
                 done = true;
             if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(window))
                 done = true;
+            have_event = SDL_PollEvent(&event) != 0;
         }
 
+        // Nothing is drawn while minimized; the collectors keep sampling
+        if (done || minimized) continue;
+        since_last_frame = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - last_frame).count();
+        bool draw_input = input_frames > 0 && (focused || since_last_frame >= unfocused_frame_ms);
+        bool draw_data = data_changed && since_last_frame >= frame_ms;
+        if (!draw_input && !draw_data) continue;
+        if (input_frames > 0) input_frames--;
+        data_changed = false;
+        last_frame = std::chrono::steady_clock::now();
+
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL2_NewFrame(window);
         ImGui::NewFrame();
 
+        std::unique_lock<std::mutex> data_lock(monitor_data_mutex);
+
+        // Pick up the latest frames from remote agents
+        if (!agent_addresses.empty()) {
+            getRemoteHosts(remote_hosts);
+        }
+
         // Create main window
         ImGui::SetNextWindowPos(ImVec2(0, 0));
         ImGui::SetNextWindowSize(io.DisplaySize);
         if (ImGui::Begin("System Monitor", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse)) {
-            
+
+            const RemoteHost* remote = viewedRemoteHost();
+            if (remote) {
+                ImGui::Text("Viewing remote host: %s (%s)", remote->snapshot.system.hostname.c_str(), remote->address.c_str());
+                ImGui::SameLine();
+                if (ImGui::SmallButton("Show local machine")) {
+                    viewed_host = -1;
+                }
+            }
+
+            connections_shown = false;
             if (ImGui::BeginTabBar("MainTabBar")) {
-                
+
+                if (!agent_addresses.empty() && ImGui::BeginTabItem("Hosts")) {
+                    renderHostGrid();
+                    ImGui::EndTabItem();
+                }
+
                 if (ImGui::BeginTabItem("System")) {
                     renderSystemMonitor();
                     ImGui::EndTabItem();
                 }
-                
+
                 if (ImGui::BeginTabItem("Memory & Processes")) {
                     renderMemoryAndProcessMonitor();
                     ImGui::EndTabItem();
                 }
-                
+
                 if (ImGui::BeginTabItem("Network")) {
                     renderNetworkMonitor();
                     ImGui::EndTabItem();
                 }
-                
+
                 ImGui::EndTabBar();
             }
+            connections_visible = connections_shown;
         }
         ImGui::End();
 
+        if (gpu_timing) {
+            renderGpuTimingOverlay();
+        }
+
         // Rendering
         ImGui::Render();
+        data_lock.unlock();
         glViewport(0, 0, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
         glClearColor(0.45f, 0.55f, 0.60f, 1.00f);
         glClear(GL_COLOR_BUFFER_BIT);
+        if (gpu_timing) beginGpuTimer();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        if (gpu_timing) endGpuTimer();
         SDL_GL_SwapWindow(window);
     }
 
     // Cleanup
+    stopScheduler();
+    stopProcessNuma();
+    stopStreamViewer();
+    stopSampler();
+    stopSharedSnapshot();
+    stopStreamAgent();
+    stopMetricsServer();
+    stopFilesystemMonitor();
+    shutdownGpuPlots();
+    shutdownGpuTimer();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
@@ -1,55 +1,125 @@
 #include "header.h"
+#include <cstring>
+#include <fcntl.h>
 
-MemoryInfo getMemoryInfo() {
-    MemoryInfo info = {};
-    
-    // Get RAM information from /proc/meminfo
-    std::ifstream meminfo("/proc/meminfo");
-    std::string line;
-    std::map<std::string, unsigned long> mem_values;
-    
-    while (std::getline(meminfo, line)) {
-        std::istringstream iss(line);
-        std::string key;
-        unsigned long value;
-        std::string unit;
-        
-        if (iss >> key >> value >> unit) {
-            // Remove the colon from key
-            if (!key.empty() && key.back() == ':') {
-                key.pop_back();
+// /proc/meminfo keys we keep, written straight into MemoryInfo members
+struct MeminfoKey {
+    const char* name;
+    unsigned long MemoryInfo::* field;
+};
+
+static const MeminfoKey meminfo_keys[] = {
+    {"MemTotal", &MemoryInfo::total_ram}, {"MemFree", &MemoryInfo::free_ram},
+    {"MemAvailable", &MemoryInfo::available_ram}, {"Buffers", &MemoryInfo::buffers},
+    {"Cached", &MemoryInfo::cached}, {"SwapTotal", &MemoryInfo::total_swap},
+    {"SwapFree", &MemoryInfo::free_swap}, {"Dirty", &MemoryInfo::dirty},
+    {"Writeback", &MemoryInfo::writeback}, {"AnonPages", &MemoryInfo::anon_pages},
+    {"Mapped", &MemoryInfo::mapped}, {"Shmem", &MemoryInfo::shmem},
+    {"Slab", &MemoryInfo::slab}, {"SReclaimable", &MemoryInfo::slab_reclaimable},
+    {"CommitLimit", &MemoryInfo::commit_limit}, {"Committed_AS", &MemoryInfo::committed_as},
+    {"HugePages_Total", &MemoryInfo::hugepages_total}, {"HugePages_Free", &MemoryInfo::hugepages_free},
+    {"HugePages_Rsvd", &MemoryInfo::hugepages_reserved}, {"HugePages_Surp", &MemoryInfo::hugepages_surplus},
+    {"Hugepagesize", &MemoryInfo::hugepage_size},
+};
+
+// Open-addressed table over the keys above, built once. Lookups hash the key
+// bytes in place, so parsing a line allocates nothing.
+#define MEMINFO_TABLE_SIZE 64
+static const MeminfoKey* meminfo_table[MEMINFO_TABLE_SIZE];
+
+static unsigned hashMeminfoKey(const char* key, size_t length) {
+    unsigned hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)key[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool buildMeminfoTable() {
+    for (const MeminfoKey& key : meminfo_keys) {
+        unsigned slot = hashMeminfoKey(key.name, strlen(key.name)) % MEMINFO_TABLE_SIZE;
+        while (meminfo_table[slot]) slot = (slot + 1) % MEMINFO_TABLE_SIZE;
+        meminfo_table[slot] = &key;
+    }
+    return true;
+}
+
+static const MeminfoKey* findMeminfoKey(const char* key, size_t length) {
+    unsigned slot = hashMeminfoKey(key, length) % MEMINFO_TABLE_SIZE;
+    while (const MeminfoKey* entry = meminfo_table[slot]) {
+        if (strncmp(entry->name, key, length) == 0 && entry->name[length] == '\0') return entry;
+        slot = (slot + 1) % MEMINFO_TABLE_SIZE;
+    }
+    return nullptr;
+}
+
+// Fills the meminfo fields of info; returns false if /proc/meminfo could not be read
+static bool readMeminfo(MemoryInfo& info) {
+    static const bool table_ready = buildMeminfoTable();
+    (void)table_ready;
+
+    int fd = open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // The whole file is well under a page or two
+    char buffer[8192];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0) return false;
+    buffer[length] = '\0';
+
+    // Lines look like "MemTotal:       16318412 kB"
+    bool has_available = false;
+    for (char* line = buffer; *line; ) {
+        char* colon = strchr(line, ':');
+        char* end = strchr(line, '\n');
+        if (!end) end = buffer + length;
+        if (colon && colon < end) {
+            const MeminfoKey* key = findMeminfoKey(line, colon - line);
+            if (key) {
+                info.*(key->field) = strtoul(colon + 1, nullptr, 10);
+                if (key->field == &MemoryInfo::available_ram) has_available = true;
             }
-            mem_values[key] = value; // Values are in kB
         }
+        line = *end ? end + 1 : end;
     }
+
+    // Kernels before 3.14 have no MemAvailable; approximate it the way the kernel does
+    if (!has_available) {
+        unsigned long reclaimable = info.buffers + info.cached + info.slab_reclaimable;
+        info.available_ram = info.free_ram + (reclaimable > info.shmem ? reclaimable - info.shmem : 0);
+    }
+    return true;
+}
+
+MemoryInfo getMemoryInfo() {
+    MemoryInfo info = {};
     
-    info.total_ram = mem_values["MemTotal"];
-    info.free_ram = mem_values["MemFree"] + mem_values["Buffers"] + mem_values["Cached"];
-    info.used_ram = info.total_ram - info.free_ram;
-    
-    info.total_swap = mem_values["SwapTotal"];
-    info.free_swap = mem_values["SwapFree"];
-    info.used_swap = info.total_swap - info.free_swap;
+    if (readMeminfo(info)) {
+        info.available_ram = std::min(info.available_ram, info.total_ram);
+        info.used_ram = info.total_ram - info.available_ram;
+        info.used_swap = info.total_swap > info.free_swap ? info.total_swap - info.free_swap : 0;
+    }
     
-    // Get disk information
-    struct statvfs disk_stat;
-    if (statvfs("/", &disk_stat) == 0) {
-        info.total_disk = (disk_stat.f_blocks * disk_stat.f_frsize) / 1024; // Convert to kB
-        info.free_disk = (disk_stat.f_bavail * disk_stat.f_frsize) / 1024;
-        info.used_disk = info.total_disk - info.free_disk;
+    // Root filesystem from the filesystem monitor, which never blocks on statvfs
+    MountInfo root;
+    if (getFilesystem("/", root) && root.has_usage) {
+        info.total_disk = root.total_kb;
+        info.free_disk = root.free_kb;
+        info.used_disk = root.used_kb;
     }
     
     return info;
 }
 
-std::vector<ProcessInfo> getProcesses() {
+std::vector<ProcessInfo> getProcesses(const SampleContext& context) {
     std::vector<ProcessInfo> processes;
     
     DIR* proc_dir = opendir("/proc");
     if (!proc_dir) return processes;
     
-    // Get total system memory for percentage calculations
-    MemoryInfo mem_info = getMemoryInfo();
+    // Total memory for percentages: this tick's meminfo if read, otherwise the boot-time total
+    unsigned long total_ram = context.memory ? context.memory->total_ram : context.facts->total_ram;
     
     struct dirent* entry;
     while ((entry = readdir(proc_dir)) != nullptr) {
@@ -75,9 +145,16 @@ std::vector<ProcessInfo> getProcesses() {
         std::string stat_line;
         if (!std::getline(stat_file, stat_line)) continue;
         
-        std::istringstream iss(stat_line);
+        // The name is in parentheses and may itself hold spaces or ')', so the
+        // other fields are split from after the last ')'
+        size_t open_paren = stat_line.find('(');
+        size_t close_paren = stat_line.rfind(')');
+        if (open_paren == std::string::npos || close_paren == std::string::npos || close_paren < open_paren) continue;
+        proc.name = stat_line.substr(open_paren + 1, close_paren - open_paren - 1);
+        
+        std::istringstream iss(stat_line.substr(close_paren + 1));
         std::string token;
-        std::vector<std::string> stat_fields;
+        std::vector<std::string> stat_fields = {entry->d_name, proc.name}; // indexes match proc(5), from 0
         
         // Parse stat line
         while (iss >> token) {
@@ -86,12 +163,6 @@ std::vector<ProcessInfo> getProcesses() {
         
         if (stat_fields.size() < 24) continue;
         
-        // Extract process name (remove parentheses)
-        proc.name = stat_fields[1];
-        if (proc.name.size() >= 2 && proc.name[0] == '(' && proc.name.back() == ')') {
-            proc.name = proc.name.substr(1, proc.name.size() - 2);
-        }
-        
         // Extract state
         proc.state = stat_fields[2];
         
@@ -99,7 +170,10 @@ std::vector<ProcessInfo> getProcesses() {
         unsigned long utime = std::stoul(stat_fields[13]);
         unsigned long stime = std::stoul(stat_fields[14]);
         unsigned long total_time = utime + stime;
-        proc.cpu_usage = (total_time / 100.0f) * 0.01f; // Simplified calculation
+        proc.cpu_usage = (total_time / (float)context.facts->clock_ticks) * 0.01f; // Simplified calculation
+        proc.start_time = std::stoull(stat_fields[21]);
+        proc.cpu_ticks = total_time;
+        proc.processor = stat_fields.size() > 38 ? atoi(stat_fields[38].c_str()) : -1;
         
         // Get memory usage from /proc/PID/status
         proc.memory_kb = 0;
@@ -117,8 +191,8 @@ std::vector<ProcessInfo> getProcesses() {
                     std::string unit;
                     if (status_iss >> key >> value >> unit) {
                         proc.memory_kb = value;
-                        if (mem_info.total_ram > 0) {
-                            proc.memory_usage = (value * 100.0f) / mem_info.total_ram;
+                        if (total_ram > 0) {
+                            proc.memory_usage = (value * 100.0f) / total_ram;
                         }
                     }
                     break;
@@ -131,6 +205,8 @@ std::vector<ProcessInfo> getProcesses() {
     
     closedir(proc_dir);
     
+    updateProcessIo(processes);
+    
     // Sort processes by CPU usage (descending)
     std::sort(processes.begin(), processes.end(), 
               [](const ProcessInfo& a, const ProcessInfo& b) {
@@ -0,0 +1,417 @@
+#include "header.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// Exporter state
+static std::atomic<bool> metrics_running(false);
+static std::thread metrics_server_thread;
+static std::mutex metrics_mutex;
+static std::shared_ptr<const std::string> metrics_body = std::make_shared<const std::string>();
+static int metrics_listen_fd = -1;
+
+// Escape a label value as required by the exposition format
+static std::string escapeLabel(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out += c; break;
+        }
+    }
+    return out;
+}
+
+static void writeHeader(std::ostringstream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+MetricsSnapshot collectMetricsSnapshot(CPUInfo& prev_cpu, int top_processes) {
+    MetricsSnapshot snapshot;
+
+    // CPU usage is computed against the caller's previous sample, not getCPUInfo()'s
+    if (readCPUTimes(snapshot.cpu)) {
+        snapshot.cpu.usage_percent = cpuUsageBetween(prev_cpu, snapshot.cpu);
+        prev_cpu = snapshot.cpu;
+    }
+
+    // Each source is read once per tick; later collectors reuse earlier results
+    SampleContext context = makeSampleContext();
+    snapshot.memory = getMemoryInfo();
+    context.memory = &snapshot.memory;
+
+    // getProcesses() already returns processes sorted by CPU usage
+    snapshot.top_processes = getProcesses(context);
+    context.processes = &snapshot.top_processes;
+    snapshot.system = getSystemInfo(context);
+
+    snapshot.interfaces = getNetworkInfo();
+    readSensors(snapshot.sensors);
+    snapshot.thermal = thermalFromSensors(snapshot.sensors);
+    snapshot.fan = fanFromSensors(snapshot.sensors);
+    readVmStat(snapshot.vmstat);
+    getFilesystems(snapshot.filesystems);
+
+    if (top_processes >= 0 && snapshot.top_processes.size() > (size_t)top_processes) {
+        snapshot.top_processes.resize(top_processes);
+    }
+
+    snapshot.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return snapshot;
+}
+
+std::string serializeMetrics(const MetricsSnapshot& snapshot) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+
+    // Host and process summary
+    writeHeader(out, "system_monitor_host_info", "gauge", "Static host facts, always 1.");
+    out << "system_monitor_host_info{hostname=\"" << escapeLabel(snapshot.system.hostname)
+        << "\",os=\"" << escapeLabel(snapshot.system.os_type)
+        << "\",cpu=\"" << escapeLabel(snapshot.system.cpu_type) << "\"} 1\n";
+    writeHeader(out, "system_monitor_processes", "gauge", "Number of processes by state.");
+    const std::pair<const char*, int> process_states[] = {
+        {"running", snapshot.system.running_processes}, {"sleeping", snapshot.system.sleeping_processes},
+        {"zombie", snapshot.system.zombie_processes}, {"stopped", snapshot.system.stopped_processes}
+    };
+    out << "system_monitor_processes{state=\"all\"} " << snapshot.system.total_processes << "\n";
+    for (const auto& state : process_states) {
+        out << "system_monitor_processes{state=\"" << state.first << "\"} " << state.second << "\n";
+    }
+
+    // CPU
+    double ticks = (double)getHostFacts().clock_ticks;
+    writeHeader(out, "system_monitor_cpu_usage_percent", "gauge", "Total CPU utilisation over the last sample interval.");
+    out << "system_monitor_cpu_usage_percent " << snapshot.cpu.usage_percent << "\n";
+    writeHeader(out, "system_monitor_cpu_seconds_total", "counter", "Seconds the CPUs spent in each mode.");
+    const std::pair<const char*, long> cpu_modes[] = {
+        {"user", snapshot.cpu.user}, {"nice", snapshot.cpu.nice}, {"system", snapshot.cpu.system},
+        {"idle", snapshot.cpu.idle}, {"iowait", snapshot.cpu.iowait}, {"irq", snapshot.cpu.irq},
+        {"softirq", snapshot.cpu.softirq}
+    };
+    for (const auto& mode : cpu_modes) {
+        out << "system_monitor_cpu_seconds_total{mode=\"" << mode.first << "\"} " << mode.second / ticks << "\n";
+    }
+
+    // Memory, swap and disk (MemoryInfo values are in kB)
+    const struct { const char* name; const char* help; unsigned long kb; } gauges[] = {
+        {"system_monitor_memory_total_bytes", "Physical memory size.", snapshot.memory.total_ram},
+        {"system_monitor_memory_used_bytes", "Physical memory in use.", snapshot.memory.used_ram},
+        {"system_monitor_memory_free_bytes", "Physical memory not used for anything, including cache (MemFree).", snapshot.memory.free_ram},
+        {"system_monitor_memory_available_bytes", "Physical memory available without swapping (MemAvailable).", snapshot.memory.available_ram},
+        {"system_monitor_memory_buffers_bytes", "Block device buffers.", snapshot.memory.buffers},
+        {"system_monitor_memory_cached_bytes", "Page cache, including shmem.", snapshot.memory.cached},
+        {"system_monitor_memory_shmem_bytes", "Shared memory and tmpfs.", snapshot.memory.shmem},
+        {"system_monitor_memory_slab_bytes", "Kernel slab allocations.", snapshot.memory.slab},
+        {"system_monitor_memory_slab_reclaimable_bytes", "Reclaimable part of the kernel slab.", snapshot.memory.slab_reclaimable},
+        {"system_monitor_memory_anon_bytes", "Anonymous pages mapped into user processes.", snapshot.memory.anon_pages},
+        {"system_monitor_memory_mapped_bytes", "File pages mapped into user processes.", snapshot.memory.mapped},
+        {"system_monitor_memory_dirty_bytes", "Memory waiting to be written back to disk.", snapshot.memory.dirty},
+        {"system_monitor_memory_writeback_bytes", "Memory being written back to disk.", snapshot.memory.writeback},
+        {"system_monitor_memory_commit_limit_bytes", "Total memory that can be committed (CommitLimit).", snapshot.memory.commit_limit},
+        {"system_monitor_memory_committed_bytes", "Memory committed by all processes (Committed_AS).", snapshot.memory.committed_as},
+        {"system_monitor_hugepage_size_bytes", "Size of a huge page.", snapshot.memory.hugepage_size},
+        {"system_monitor_swap_total_bytes", "Swap size.", snapshot.memory.total_swap},
+        {"system_monitor_swap_used_bytes", "Swap in use.", snapshot.memory.used_swap},
+        {"system_monitor_swap_free_bytes", "Swap free.", snapshot.memory.free_swap},
+        {"system_monitor_disk_total_bytes", "Root filesystem size.", snapshot.memory.total_disk},
+        {"system_monitor_disk_used_bytes", "Root filesystem space in use.", snapshot.memory.used_disk},
+        {"system_monitor_disk_free_bytes", "Root filesystem space available.", snapshot.memory.free_disk},
+    };
+    for (const auto& gauge : gauges) {
+        writeHeader(out, gauge.name, "gauge", gauge.help);
+        out << gauge.name << " " << gauge.kb * 1024ULL << "\n";
+    }
+
+    writeHeader(out, "system_monitor_hugepages", "gauge", "Huge pages in the pool, by state.");
+    const std::pair<const char*, unsigned long> hugepage_states[] = {
+        {"total", snapshot.memory.hugepages_total}, {"free", snapshot.memory.hugepages_free},
+        {"reserved", snapshot.memory.hugepages_reserved}, {"surplus", snapshot.memory.hugepages_surplus},
+    };
+    for (const auto& state : hugepage_states) {
+        out << "system_monitor_hugepages{state=\"" << state.first << "\"} " << state.second << "\n";
+    }
+
+    // Every real mounted filesystem
+    const struct { const char* name; const char* help; unsigned long long MountInfo::* field; } fs_gauges[] = {
+        {"system_monitor_filesystem_inodes", "Inodes on the filesystem.", &MountInfo::inodes_total},
+        {"system_monitor_filesystem_inodes_free", "Free inodes on the filesystem.", &MountInfo::inodes_free},
+    };
+    const struct { const char* name; const char* help; unsigned long MountInfo::* kb; } fs_sizes[] = {
+        {"system_monitor_filesystem_size_bytes", "Filesystem size.", &MountInfo::total_kb},
+        {"system_monitor_filesystem_used_bytes", "Filesystem space in use.", &MountInfo::used_kb},
+        {"system_monitor_filesystem_avail_bytes", "Filesystem space available to unprivileged users.", &MountInfo::free_kb},
+    };
+    auto filesystemLabels = [](const MountInfo& fs) {
+        return "{mountpoint=\"" + escapeLabel(fs.mount_point) + "\",fstype=\"" + escapeLabel(fs.fs_type) +
+               "\",device=\"" + escapeLabel(fs.device) + "\"}";
+    };
+    for (const auto& size : fs_sizes) {
+        writeHeader(out, size.name, "gauge", size.help);
+        for (const auto& fs : snapshot.filesystems) {
+            if (fs.has_usage) out << size.name << filesystemLabels(fs) << " " << (fs.*size.kb) * 1024ULL << "\n";
+        }
+    }
+    for (const auto& gauge : fs_gauges) {
+        writeHeader(out, gauge.name, "gauge", gauge.help);
+        for (const auto& fs : snapshot.filesystems) {
+            if (fs.has_usage) out << gauge.name << filesystemLabels(fs) << " " << fs.*gauge.field << "\n";
+        }
+    }
+    writeHeader(out, "system_monitor_filesystem_stale", "gauge", "Whether the last statvfs on the filesystem timed out.");
+    for (const auto& fs : snapshot.filesystems) {
+        out << "system_monitor_filesystem_stale" << filesystemLabels(fs) << " " << (fs.stale ? 1 : 0) << "\n";
+    }
+
+    // Kernel VM activity
+    const struct { const char* name; const char* help; unsigned long VmStatInfo::* field; } vm_counters[] = {
+        {"system_monitor_vm_page_faults_total", "Page faults.", &VmStatInfo::pgfault},
+        {"system_monitor_vm_major_page_faults_total", "Page faults that needed disk I/O.", &VmStatInfo::pgmajfault},
+        {"system_monitor_vm_swap_in_pages_total", "Pages swapped in.", &VmStatInfo::pswpin},
+        {"system_monitor_vm_swap_out_pages_total", "Pages swapped out.", &VmStatInfo::pswpout},
+        {"system_monitor_vm_scan_kswapd_pages_total", "Pages scanned by kswapd.", &VmStatInfo::pgscan_kswapd},
+        {"system_monitor_vm_scan_direct_pages_total", "Pages scanned by direct reclaim.", &VmStatInfo::pgscan_direct},
+        {"system_monitor_vm_steal_kswapd_pages_total", "Pages reclaimed by kswapd.", &VmStatInfo::pgsteal_kswapd},
+        {"system_monitor_vm_steal_direct_pages_total", "Pages reclaimed by direct reclaim.", &VmStatInfo::pgsteal_direct},
+        {"system_monitor_vm_alloc_stalls_total", "Allocations that stalled in direct reclaim.", &VmStatInfo::allocstall},
+        {"system_monitor_vm_compact_stalls_total", "Allocations that stalled in compaction.", &VmStatInfo::compact_stall},
+        {"system_monitor_vm_thp_fault_alloc_total", "Huge pages allocated on fault.", &VmStatInfo::thp_fault_alloc},
+        {"system_monitor_vm_thp_fault_fallback_total", "Huge page faults that fell back to small pages.", &VmStatInfo::thp_fault_fallback},
+        {"system_monitor_vm_thp_collapse_alloc_total", "Huge pages allocated by khugepaged.", &VmStatInfo::thp_collapse_alloc},
+        {"system_monitor_vm_thp_split_total", "Huge pages split.", &VmStatInfo::thp_split_page},
+        {"system_monitor_vm_oom_kills_total", "Processes killed by the OOM killer.", &VmStatInfo::oom_kill},
+    };
+    for (const auto& counter : vm_counters) {
+        writeHeader(out, counter.name, "counter", counter.help);
+        out << counter.name << " " << snapshot.vmstat.*counter.field << "\n";
+    }
+
+    // Network interface counters
+    const struct { const char* name; const char* help; unsigned long NetworkInterface::* field; } net_counters[] = {
+        {"system_monitor_network_receive_bytes_total", "Bytes received.", &NetworkInterface::rx_bytes},
+        {"system_monitor_network_receive_packets_total", "Packets received.", &NetworkInterface::rx_packets},
+        {"system_monitor_network_receive_errors_total", "Receive errors.", &NetworkInterface::rx_errs},
+        {"system_monitor_network_receive_drop_total", "Received packets dropped.", &NetworkInterface::rx_drop},
+        {"system_monitor_network_transmit_bytes_total", "Bytes transmitted.", &NetworkInterface::tx_bytes},
+        {"system_monitor_network_transmit_packets_total", "Packets transmitted.", &NetworkInterface::tx_packets},
+        {"system_monitor_network_transmit_errors_total", "Transmit errors.", &NetworkInterface::tx_errs},
+        {"system_monitor_network_transmit_drop_total", "Transmitted packets dropped.", &NetworkInterface::tx_drop},
+    };
+    for (const auto& counter : net_counters) {
+        writeHeader(out, counter.name, "counter", counter.help);
+        for (const auto& iface : snapshot.interfaces) {
+            out << counter.name << "{interface=\"" << escapeLabel(iface.name) << "\"} " << iface.*counter.field << "\n";
+        }
+    }
+
+    // Thermal and fan; hosts without the sensor export nothing rather than zero
+    if (snapshot.thermal.available) {
+        writeHeader(out, "system_monitor_temperature_celsius", "gauge", "CPU temperature.");
+        out << "system_monitor_temperature_celsius " << snapshot.thermal.temperature << "\n";
+    }
+    if (snapshot.fan.available) {
+        writeHeader(out, "system_monitor_fan_speed_rpm", "gauge", "Fan speed.");
+        out << "system_monitor_fan_speed_rpm " << snapshot.fan.speed << "\n";
+        writeHeader(out, "system_monitor_fan_active", "gauge", "Whether the fan is spinning.");
+        out << "system_monitor_fan_active " << (snapshot.fan.active ? 1 : 0) << "\n";
+    }
+    writeHeader(out, "system_monitor_sensor_value", "gauge", "Every hwmon and thermal zone reading, in C, RPM, V, W or A.");
+    for (const SensorReading& sensor : snapshot.sensors) {
+        if (!sensor.valid) continue;
+        out << "system_monitor_sensor_value{chip=\"" << escapeLabel(sensor.chip)
+            << "\",device=\"" << escapeLabel(sensor.device) << "\",sensor=\"" << escapeLabel(sensor.label)
+            << "\",kind=\"" << sensorKindName(sensor.kind) << "\"} " << sensor.value << "\n";
+    }
+    writeHeader(out, "system_monitor_sensor_critical", "gauge", "Upper limit of each sensor that has one.");
+    for (const SensorReading& sensor : snapshot.sensors) {
+        if (sensor.critical <= 0.0f) continue;
+        out << "system_monitor_sensor_critical{chip=\"" << escapeLabel(sensor.chip)
+            << "\",device=\"" << escapeLabel(sensor.device) << "\",sensor=\"" << escapeLabel(sensor.label)
+            << "\",kind=\"" << sensorKindName(sensor.kind) << "\"} " << sensor.critical << "\n";
+    }
+
+    // Top-N processes by CPU
+    writeHeader(out, "system_monitor_process_cpu_usage_percent", "gauge", "CPU usage of the top processes.");
+    for (const auto& proc : snapshot.top_processes) {
+        out << "system_monitor_process_cpu_usage_percent{pid=\"" << proc.pid << "\",name=\""
+            << escapeLabel(proc.name) << "\"} " << proc.cpu_usage << "\n";
+    }
+    writeHeader(out, "system_monitor_process_resident_memory_bytes", "gauge", "Resident set size of the top processes.");
+    for (const auto& proc : snapshot.top_processes) {
+        out << "system_monitor_process_resident_memory_bytes{pid=\"" << proc.pid << "\",name=\""
+            << escapeLabel(proc.name) << "\"} " << proc.memory_kb * 1024ULL << "\n";
+    }
+
+    writeHeader(out, "system_monitor_last_sample_timestamp_seconds", "gauge", "Unix time of the sample being served.");
+    out << "system_monitor_last_sample_timestamp_seconds " << snapshot.timestamp_ms / 1000.0 << "\n";
+
+    return out.str();
+}
+
+// Called from the sampler thread: serialize once, serve to every scraper
+static void publishMetrics(const MetricsSnapshot& snapshot) {
+    auto body = std::make_shared<const std::string>(serializeMetrics(snapshot));
+    std::lock_guard<std::mutex> lock(metrics_mutex);
+    metrics_body = body;
+}
+
+// Per-connection state for the HTTP server
+struct MetricsConnection {
+    int fd;
+    std::string request;
+    std::string head;
+    std::shared_ptr<const std::string> body;
+    size_t sent = 0;
+    bool responding = false;
+};
+
+static void prepareResponse(MetricsConnection& conn) {
+    std::istringstream iss(conn.request);
+    std::string method, path;
+    iss >> method >> path;
+
+    std::string status = "200 OK";
+    std::string content_type = "text/plain; version=0.0.4; charset=utf-8";
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        conn.body = std::make_shared<const std::string>("method not allowed\n");
+    } else if (path == "/metrics" || path.rfind("/metrics?", 0) == 0) {
+        std::lock_guard<std::mutex> lock(metrics_mutex);
+        conn.body = metrics_body;
+    } else {
+        status = "404 Not Found";
+        conn.body = std::make_shared<const std::string>("see /metrics\n");
+    }
+
+    conn.head = "HTTP/1.1 " + status + "\r\n"
+                "Content-Type: " + content_type + "\r\n"
+                "Content-Length: " + std::to_string(conn.body->size()) + "\r\n"
+                "Connection: close\r\n\r\n";
+    if (method == "HEAD") {
+        conn.body = std::make_shared<const std::string>();
+    }
+    conn.responding = true;
+}
+
+// Returns false once the connection should be closed
+static bool serviceConnection(MetricsConnection& conn, short revents) {
+    if (revents & (POLLERR | POLLHUP | POLLNVAL)) return false;
+
+    if (!conn.responding && (revents & POLLIN)) {
+        char buf[2048];
+        ssize_t n = recv(conn.fd, buf, sizeof(buf), 0);
+        if (n <= 0) return n < 0 && (errno == EAGAIN || errno == EINTR);
+        conn.request.append(buf, n);
+        if (conn.request.size() > 16384) return false;
+        if (conn.request.find("\r\n\r\n") != std::string::npos || conn.request.find("\n\n") != std::string::npos) {
+            prepareResponse(conn);
+        }
+    }
+
+    if (conn.responding) {
+        size_t total = conn.head.size() + conn.body->size();
+        while (conn.sent < total) {
+            const char* data;
+            size_t len;
+            if (conn.sent < conn.head.size()) {
+                data = conn.head.data() + conn.sent;
+                len = conn.head.size() - conn.sent;
+            } else {
+                data = conn.body->data() + (conn.sent - conn.head.size());
+                len = total - conn.sent;
+            }
+            ssize_t n = send(conn.fd, data, len, MSG_NOSIGNAL);
+            if (n < 0) return errno == EAGAIN || errno == EINTR;
+            conn.sent += n;
+        }
+        return false;
+    }
+    return true;
+}
+
+static void metricsServerLoop() {
+    std::vector<MetricsConnection> connections;
+    std::vector<pollfd> fds;
+
+    while (metrics_running) {
+        fds.clear();
+        fds.push_back({metrics_listen_fd, POLLIN, 0});
+        for (const auto& conn : connections) {
+            fds.push_back({conn.fd, (short)(conn.responding ? POLLOUT : POLLIN), 0});
+        }
+
+        // Wake up periodically to notice shutdown
+        if (poll(fds.data(), fds.size(), 250) <= 0) continue;
+
+        for (size_t i = connections.size(); i-- > 0;) {
+            if (fds[i + 1].revents == 0) continue;
+            if (!serviceConnection(connections[i], fds[i + 1].revents)) {
+                close(connections[i].fd);
+                connections.erase(connections.begin() + i);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd;
+            while ((fd = accept4(metrics_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                MetricsConnection conn;
+                conn.fd = fd;
+                connections.push_back(conn);
+            }
+        }
+    }
+
+    for (const auto& conn : connections) {
+        close(conn.fd);
+    }
+}
+
+bool startMetricsServer(const MetricsSettings& settings) {
+    if (metrics_running || settings.port <= 0) return false;
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(settings.port);
+    if (inet_pton(AF_INET, settings.address.c_str(), &addr.sin_addr) != 1) {
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 64) != 0) {
+        close(fd);
+        return false;
+    }
+
+    metrics_listen_fd = fd;
+    metrics_running = true;
+    addSnapshotListener(publishMetrics);
+    metrics_server_thread = std::thread(metricsServerLoop);
+    return true;
+}
+
+void stopMetricsServer() {
+    if (!metrics_running) return;
+
+    metrics_running = false;
+    if (metrics_server_thread.joinable()) metrics_server_thread.join();
+
+    close(metrics_listen_fd);
+    metrics_listen_fd = -1;
+}
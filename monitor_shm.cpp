@@ -0,0 +1,93 @@
+// monitor-shm: print the snapshot a running monitor publishes with --shm.
+// Reads shared memory only, so it is cheap enough for shell prompts and health checks.
+
+#include "shm_snapshot.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+static void printUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [--name NAME] [--prompt] [--watch SEC]\n"
+                    "  --name NAME   shared-memory region (default %s)\n"
+                    "  --prompt      print a single compact line\n"
+                    "  --watch SEC   keep printing every SEC seconds\n",
+            program, SHARED_SNAPSHOT_DEFAULT_NAME);
+}
+
+static void printPrompt(const SharedSnapshotData& data) {
+    double ram_percent = data.total_ram > 0 ? 100.0 * data.used_ram / data.total_ram : 0.0;
+    printf("cpu %.0f%% mem %.0f%%", data.cpu_usage, ram_percent);
+    if (data.temperature_available) printf(" %.0fC", data.temperature);
+    printf("\n");
+}
+
+static void printFull(const SharedSnapshotData& data) {
+    printf("hostname: %s\n", data.hostname);
+    printf("os: %s\n", data.os_type);
+    printf("timestamp_ms: %lld\n", (long long)data.timestamp_ms);
+    printf("cpu_usage: %.1f\n", data.cpu_usage);
+    printf("ram_kb: %llu used / %llu total\n", (unsigned long long)data.used_ram, (unsigned long long)data.total_ram);
+    printf("swap_kb: %llu used / %llu total\n", (unsigned long long)data.used_swap, (unsigned long long)data.total_swap);
+    printf("disk_kb: %llu used / %llu total\n", (unsigned long long)data.used_disk, (unsigned long long)data.total_disk);
+    if (data.temperature_available) printf("temperature: %.1f\n", data.temperature);
+    if (data.fan_available) printf("fan_rpm: %d\n", data.fan_speed);
+    printf("processes: %d total, %d running, %d sleeping, %d zombie, %d stopped\n",
+           data.total_processes, data.running_processes, data.sleeping_processes,
+           data.zombie_processes, data.stopped_processes);
+
+    for (uint32_t i = 0; i < data.interface_count; i++) {
+        const SharedInterface& iface = data.interfaces[i];
+        printf("interface %s: rx %llu bytes, tx %llu bytes\n", iface.name,
+               (unsigned long long)iface.rx_bytes, (unsigned long long)iface.tx_bytes);
+    }
+    for (uint32_t i = 0; i < data.process_count; i++) {
+        const SharedProcess& proc = data.processes[i];
+        printf("process %d %s [%s]: cpu %.1f%%, mem %.1f%%\n", proc.pid, proc.name, proc.state,
+               proc.cpu_usage, proc.memory_usage);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string name = SHARED_SNAPSHOT_DEFAULT_NAME;
+    bool prompt = false;
+    double watch = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--name" && i + 1 < argc) {
+            name = argv[++i];
+        } else if (arg == "--prompt") {
+            prompt = true;
+        } else if (arg == "--watch" && i + 1 < argc) {
+            watch = atof(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    const SharedSnapshot* snapshot = openSharedSnapshot(name.c_str());
+    if (!snapshot) {
+        fprintf(stderr, "No snapshot published at %s (is the monitor running with --shm?)\n", name.c_str());
+        return 1;
+    }
+
+    SharedSnapshotData data;
+    do {
+        if (!readSharedSnapshot(snapshot, data)) {
+            fprintf(stderr, "No consistent snapshot available yet\n");
+            closeSharedSnapshot(snapshot);
+            return 1;
+        }
+        if (prompt) {
+            printPrompt(data);
+        } else {
+            printFull(data);
+        }
+        fflush(stdout);
+        if (watch > 0.0) usleep((useconds_t)(watch * 1000000.0));
+    } while (watch > 0.0);
+
+    closeSharedSnapshot(snapshot);
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include "header.h"
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+#include <net/if_arp.h>
+
+// Interface counters from netlink instead of /proc/net/dev text. Each refresh is
+// a single RTM_GETSTATS dump filtered to rtnl_link_stats64, which is far smaller
+// than an RTM_GETLINK dump. Names, link state and addresses live in a cache that
+// is filled by one RTM_GETLINK and one RTM_GETADDR dump at start and afterwards
+// changed only by RTM_NEWLINK/DELLINK and RTM_NEWADDR/DELADDR notifications.
+#define NETLINK_BUFFER_BYTES (64 * 1024)
+
+struct LinkEntry {
+    std::string name;
+    std::string group;
+    unsigned char operstate = 0xff;
+    int speed_mbps = 0;
+    std::vector<std::string> ipv4;
+    std::vector<std::string> ipv6;
+};
+
+static std::mutex netlink_mutex; // the GUI and the sampler both collect
+static int netlink_dump_fd = -1;
+static int netlink_notify_fd = -1;
+static bool netlink_failed = false;
+static unsigned int netlink_seq = 0;
+static std::vector<char> netlink_buffer;
+static std::unordered_map<int, LinkEntry> netlink_links; // by ifindex
+static size_t netlink_last_count = 0;
+
+static int openNetlink(unsigned int groups) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) return -1;
+
+    sockaddr_nl local = {};
+    local.nl_family = AF_NETLINK;
+    local.nl_groups = groups;
+    if (bind(fd, (sockaddr*)&local, sizeof(local)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Room for the largest request body we send
+struct DumpRequest {
+    nlmsghdr header;
+    union {
+        ifinfomsg link;
+        ifaddrmsg address;
+        if_stats_msg stats;
+    } body;
+};
+
+static bool sendDumpRequest(int type, const void* body, size_t body_length) {
+    DumpRequest request = {};
+    if (body_length > sizeof(request.body)) return false;
+    request.header.nlmsg_len = NLMSG_LENGTH(body_length);
+    request.header.nlmsg_type = type;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = ++netlink_seq;
+    memcpy(NLMSG_DATA(&request.header), body, body_length);
+    return send(netlink_dump_fd, &request, request.header.nlmsg_len, 0) == (ssize_t)request.header.nlmsg_len;
+}
+
+// Calls handle() for every message of the dump; false on error
+template <typename Handler>
+static bool receiveDump(Handler handle) {
+    while (true) {
+        ssize_t length = recv(netlink_dump_fd, netlink_buffer.data(), netlink_buffer.size(), 0);
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) return false;
+
+        for (nlmsghdr* msg = (nlmsghdr*)netlink_buffer.data(); NLMSG_OK(msg, (size_t)length); msg = NLMSG_NEXT(msg, length)) {
+            if (msg->nlmsg_seq != netlink_seq) continue; // left over from an abandoned dump
+            if (msg->nlmsg_type == NLMSG_DONE) return true;
+            if (msg->nlmsg_type == NLMSG_ERROR) return false;
+            handle(msg);
+        }
+    }
+}
+
+static void applyLinkMessage(const nlmsghdr* msg) {
+    const ifinfomsg* info = (const ifinfomsg*)NLMSG_DATA(msg);
+    // Bridges also announce their ports with AF_BRIDGE messages: a DELLINK on
+    // detach (the port lives on) and a NEWLINK without IFLA_LINKINFO on attach
+    if (info->ifi_family != AF_UNSPEC) return;
+    if (msg->nlmsg_type == RTM_DELLINK) {
+        netlink_links.erase(info->ifi_index);
+        return;
+    }
+    if (msg->nlmsg_type != RTM_NEWLINK) return;
+
+    LinkEntry& link = netlink_links[info->ifi_index];
+    unsigned char operstate = link.operstate;
+    std::string kind;
+    int peer_netns = -1;
+    int attr_length = IFLA_PAYLOAD(msg);
+    for (const rtattr* attr = IFLA_RTA(info); RTA_OK(attr, attr_length); attr = RTA_NEXT(attr, attr_length)) {
+        if (attr->rta_type == IFLA_IFNAME) {
+            link.name = (const char*)RTA_DATA(attr);
+        } else if (attr->rta_type == IFLA_OPERSTATE) {
+            operstate = *(const unsigned char*)RTA_DATA(attr);
+        } else if (attr->rta_type == IFLA_LINK_NETNSID) {
+            peer_netns = *(const int*)RTA_DATA(attr);
+        } else if (attr->rta_type == IFLA_LINKINFO) {
+            int info_length = RTA_PAYLOAD(attr);
+            for (const rtattr* nested = (const rtattr*)RTA_DATA(attr); RTA_OK(nested, info_length);
+                 nested = RTA_NEXT(nested, info_length)) {
+                if (nested->rta_type == IFLA_INFO_KIND) kind = (const char*)RTA_DATA(nested);
+            }
+        }
+    }
+    link.group = interfaceGroup(kind, info->ifi_type == ARPHRD_LOOPBACK, peer_netns);
+
+    // Speed only changes with the link state
+    if (operstate != link.operstate) {
+        link.operstate = operstate;
+        link.speed_mbps = readLinkSpeed(link.name);
+    }
+}
+
+static void applyAddressMessage(const nlmsghdr* msg) {
+    const ifaddrmsg* ifa = (const ifaddrmsg*)NLMSG_DATA(msg);
+    if (ifa->ifa_family != AF_INET && ifa->ifa_family != AF_INET6) return;
+
+    // IFA_LOCAL is the interface's own address on point-to-point links
+    const void* data = nullptr;
+    int attr_length = IFA_PAYLOAD(msg);
+    for (const rtattr* attr = IFA_RTA(ifa); RTA_OK(attr, attr_length); attr = RTA_NEXT(attr, attr_length)) {
+        if (attr->rta_type == IFA_LOCAL || (attr->rta_type == IFA_ADDRESS && !data)) data = RTA_DATA(attr);
+    }
+    if (!data) return;
+
+    char text[INET6_ADDRSTRLEN];
+    if (!inet_ntop(ifa->ifa_family, data, text, sizeof(text))) return;
+
+    auto link = netlink_links.find(ifa->ifa_index);
+    if (link == netlink_links.end()) return;
+    std::vector<std::string>& list = ifa->ifa_family == AF_INET ? link->second.ipv4 : link->second.ipv6;
+    auto it = std::find(list.begin(), list.end(), text);
+    if (msg->nlmsg_type == RTM_NEWADDR && it == list.end()) {
+        list.push_back(text);
+    } else if (msg->nlmsg_type == RTM_DELADDR && it != list.end()) {
+        list.erase(it);
+    }
+}
+
+static void applyNotification(const nlmsghdr* msg) {
+    switch (msg->nlmsg_type) {
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+            applyLinkMessage(msg);
+            break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+            applyAddressMessage(msg);
+            break;
+    }
+}
+
+// Rebuilds the whole cache; used at start and when notifications were lost
+static bool dumpLinksAndAddresses() {
+    netlink_links.clear();
+    ifinfomsg link_request = {};
+    link_request.ifi_family = AF_UNSPEC;
+    if (!sendDumpRequest(RTM_GETLINK, &link_request, sizeof(link_request)) || !receiveDump(applyLinkMessage)) return false;
+
+    ifaddrmsg address_request = {};
+    address_request.ifa_family = AF_UNSPEC;
+    return sendDumpRequest(RTM_GETADDR, &address_request, sizeof(address_request)) && receiveDump(applyAddressMessage);
+}
+
+static bool drainNotifications() {
+    while (true) {
+        ssize_t length = recv(netlink_notify_fd, netlink_buffer.data(), netlink_buffer.size(), MSG_DONTWAIT);
+        if (length < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            if (errno == EINTR) continue;
+            if (errno == ENOBUFS) return dumpLinksAndAddresses();
+            return false;
+        }
+        for (nlmsghdr* msg = (nlmsghdr*)netlink_buffer.data(); NLMSG_OK(msg, (size_t)length); msg = NLMSG_NEXT(msg, length)) {
+            applyNotification(msg);
+        }
+    }
+}
+
+static bool initNetlink() {
+    netlink_buffer.resize(NETLINK_BUFFER_BYTES);
+    netlink_dump_fd = openNetlink(0);
+    // Subscribe before the first dumps so no change falls between them
+    netlink_notify_fd = openNetlink(RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR);
+    if (netlink_dump_fd < 0 || netlink_notify_fd < 0 || !dumpLinksAndAddresses()) {
+        if (netlink_dump_fd >= 0) close(netlink_dump_fd);
+        if (netlink_notify_fd >= 0) close(netlink_notify_fd);
+        netlink_dump_fd = netlink_notify_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+// rtnl_link_stats64 folded into the /proc/net/dev columns the way the kernel does it
+static void copyLinkStats(const rtnl_link_stats64& stats, NetworkInterface& iface) {
+    iface.rx_bytes = stats.rx_bytes;
+    iface.rx_packets = stats.rx_packets;
+    iface.rx_errs = stats.rx_errors;
+    iface.rx_drop = stats.rx_dropped + stats.rx_missed_errors;
+    iface.rx_fifo = stats.rx_fifo_errors;
+    iface.rx_frame = stats.rx_length_errors + stats.rx_over_errors + stats.rx_crc_errors + stats.rx_frame_errors;
+    iface.rx_compressed = stats.rx_compressed;
+    iface.rx_multicast = stats.multicast;
+    iface.tx_bytes = stats.tx_bytes;
+    iface.tx_packets = stats.tx_packets;
+    iface.tx_errs = stats.tx_errors;
+    iface.tx_drop = stats.tx_dropped;
+    iface.tx_fifo = stats.tx_fifo_errors;
+    iface.tx_colls = stats.collisions;
+    iface.tx_carrier = stats.tx_carrier_errors + stats.tx_aborted_errors + stats.tx_window_errors + stats.tx_heartbeat_errors;
+    iface.tx_compressed = stats.tx_compressed;
+}
+
+bool readNetlinkInterfaces(std::vector<NetworkInterface>& interfaces) {
+    std::lock_guard<std::mutex> lock(netlink_mutex);
+    if (netlink_failed) return false;
+    if (netlink_dump_fd < 0 && !initNetlink()) {
+        netlink_failed = true;
+        return false;
+    }
+    if (!drainNotifications()) return false;
+
+    if_stats_msg request = {};
+    request.family = AF_UNSPEC;
+    request.filter_mask = IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64);
+    if (!sendDumpRequest(RTM_GETSTATS, &request, sizeof(request))) return false;
+
+    interfaces.clear();
+    interfaces.reserve(netlink_last_count);
+    bool ok = receiveDump([&](const nlmsghdr* msg) {
+        if (msg->nlmsg_type != RTM_NEWSTATS) return;
+        const if_stats_msg* stats_msg = (const if_stats_msg*)NLMSG_DATA(msg);
+
+        // A link created since the notifications were drained shows up next time
+        auto link = netlink_links.find(stats_msg->ifindex);
+        if (link == netlink_links.end()) return;
+
+        int attr_length = (int)msg->nlmsg_len - NLMSG_LENGTH(sizeof(if_stats_msg));
+        const rtattr* attr = (const rtattr*)((const char*)stats_msg + NLMSG_ALIGN(sizeof(if_stats_msg)));
+        for (; RTA_OK(attr, attr_length); attr = RTA_NEXT(attr, attr_length)) {
+            if (attr->rta_type != IFLA_STATS_LINK_64 || RTA_PAYLOAD(attr) < sizeof(rtnl_link_stats64)) continue;
+
+            rtnl_link_stats64 stats;
+            memcpy(&stats, RTA_DATA(attr), sizeof(stats)); // attributes are only 4-byte aligned
+            interfaces.emplace_back();
+            NetworkInterface& iface = interfaces.back();
+            copyLinkStats(stats, iface);
+            iface.name = link->second.name;
+            iface.group = link->second.group;
+            iface.ipv4_address = link->second.ipv4.empty() ? "N/A" : link->second.ipv4[0];
+            if (!link->second.ipv6.empty()) iface.ipv6_address = link->second.ipv6[0];
+            iface.link_speed_mbps = link->second.speed_mbps;
+            iface.ifindex = stats_msg->ifindex;
+        }
+    });
+    if (!ok) {
+        // Kernels before 4.7 have no RTM_GETSTATS; stay on the text path
+        netlink_failed = true;
+        return false;
+    }
+    netlink_last_count = interfaces.size();
+    return true;
+}
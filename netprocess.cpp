@@ -0,0 +1,128 @@
+#include "header.h"
+#include <unordered_map>
+#include <unordered_set>
+
+// Network throughput per process and cgroup from the TCP byte counters in each
+// socket dump (tcpi_bytes_acked sent, tcpi_bytes_received). Counters are kept per
+// socket cookie; a socket whose counters match the previous dump is only looked
+// up, never written. A cookie missing from the previous dump belongs to a socket
+// opened since, so all of its bytes fall in this interval. Closed sockets are
+// only searched for when the dump found fewer known cookies than were kept.
+// UDP has no such counters.
+//
+// Dumps stop while no traffic view is shown. A dump more than
+// SOCKET_BYTES_MAX_GAP seconds after the last one starts a new baseline, so the
+// first rates after that cover one interval rather than the whole pause.
+#define SOCKET_BYTES_MAX_GAP 10.0f
+struct SocketBytes {
+    unsigned long long acked = 0;
+    unsigned long long received = 0;
+};
+
+// Only the connections sampling task calls in here
+static std::unordered_map<unsigned long long, SocketBytes> socket_bytes; // cookie -> counters
+static std::unordered_map<int, std::string> process_cgroups; // pid -> cgroup path
+static std::chrono::steady_clock::time_point socket_bytes_time;
+static unsigned int socket_bytes_dumps = 0;
+
+// The unified hierarchy's "0::/path" line, else the first controller's path
+static std::string readProcessCgroup(int pid) {
+    std::ifstream cgroup_file("/proc/" + std::to_string(pid) + "/cgroup");
+    std::string line, first;
+    while (std::getline(cgroup_file, line)) {
+        size_t colon = line.find(':', line.find(':') + 1);
+        if (colon == std::string::npos) continue;
+        if (line.compare(0, 3, "0::") == 0) return line.substr(colon + 1);
+        if (first.empty()) first = line.substr(colon + 1);
+    }
+    return first;
+}
+
+void updateProcessNetwork(const std::vector<SocketInfo>& sockets, std::vector<ProcessNetwork>& processes,
+                          std::vector<CgroupNetwork>& cgroups) {
+    auto now = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(now - socket_bytes_time).count();
+    if (socket_bytes_dumps > 0 && seconds > SOCKET_BYTES_MAX_GAP) {
+        socket_bytes.clear();
+        socket_bytes_dumps = 0;
+    }
+    bool has_baseline = socket_bytes_dumps++ > 0;
+    size_t known = socket_bytes.size();
+    size_t found = 0;
+
+    std::unordered_map<int, ProcessNetwork> by_pid;
+    for (const SocketInfo& socket : sockets) {
+        if (!socket.has_tcp_info) continue;
+        ProcessNetwork& process = by_pid[socket.pid];
+        process.sockets++;
+
+        auto it = socket_bytes.find(socket.cookie);
+        if (it != socket_bytes.end()) {
+            found++;
+            if (it->second.acked == socket.bytes_acked && it->second.received == socket.bytes_received) continue;
+        } else {
+            it = socket_bytes.emplace(socket.cookie, SocketBytes()).first;
+            // New sockets count from zero, except in the first dump
+            if (!has_baseline) {
+                it->second.acked = socket.bytes_acked;
+                it->second.received = socket.bytes_received;
+                continue;
+            }
+        }
+        SocketBytes& bytes = it->second;
+        auto delta = [](unsigned long long before, unsigned long long after) { return after >= before ? after - before : 0ULL; };
+        process.tx_rate += delta(bytes.acked, socket.bytes_acked);
+        process.rx_rate += delta(bytes.received, socket.bytes_received);
+        bytes.acked = socket.bytes_acked;
+        bytes.received = socket.bytes_received;
+    }
+
+    // Closed sockets drop out; a dump that found every kept cookie closed none
+    if (found < known) {
+        std::unordered_set<unsigned long long> open;
+        open.reserve(sockets.size());
+        for (const SocketInfo& socket : sockets) {
+            if (socket.has_tcp_info) open.insert(socket.cookie);
+        }
+        for (auto it = socket_bytes.begin(); it != socket_bytes.end(); ) {
+            it = open.count(it->first) ? std::next(it) : socket_bytes.erase(it);
+        }
+    }
+    socket_bytes_time = now;
+
+    // Names come with the sockets; cgroups are read once per process
+    std::unordered_map<int, const SocketInfo*> owners;
+    for (const SocketInfo& socket : sockets) {
+        if (socket.has_tcp_info && socket.pid >= 0) owners.emplace(socket.pid, &socket);
+    }
+    for (auto it = process_cgroups.begin(); it != process_cgroups.end(); ) {
+        it = owners.count(it->first) ? std::next(it) : process_cgroups.erase(it);
+    }
+
+    processes.clear();
+    std::map<std::string, CgroupNetwork> by_cgroup;
+    for (auto& entry : by_pid) {
+        ProcessNetwork& process = entry.second;
+        process.pid = entry.first;
+        process.rx_rate = has_baseline && seconds > 0.0f ? process.rx_rate / seconds : 0.0f;
+        process.tx_rate = has_baseline && seconds > 0.0f ? process.tx_rate / seconds : 0.0f;
+        if (process.pid >= 0) {
+            process.name = owners[process.pid]->process;
+            auto cgroup = process_cgroups.find(process.pid);
+            if (cgroup == process_cgroups.end()) {
+                cgroup = process_cgroups.emplace(process.pid, readProcessCgroup(process.pid)).first;
+            }
+            process.cgroup = cgroup->second;
+
+            CgroupNetwork& group = by_cgroup[process.cgroup];
+            group.cgroup = process.cgroup;
+            group.processes++;
+            group.rx_rate += process.rx_rate;
+            group.tx_rate += process.tx_rate;
+        }
+        processes.push_back(process);
+    }
+
+    cgroups.clear();
+    for (const auto& entry : by_cgroup) cgroups.push_back(entry.second);
+}
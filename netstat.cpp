@@ -0,0 +1,167 @@
+#include "header.h"
+#include <cstring>
+#include <fcntl.h>
+
+// Protocol counters from /proc/net/snmp and /proc/net/netstat. Both files hold
+// pairs of lines, a header naming the columns and a line of values:
+//   Tcp: RtoAlgorithm RtoMin RtoMax MaxConn ActiveOpens ...
+//   Tcp: 1 200 120000 -1 4031 ...
+// The column order differs between kernels but never changes while we run, so
+// each header is mapped to our fields once and the value lines are then read as
+// a plain run of numbers. A header that differs from the mapped one is mapped again.
+static const struct {
+    const char* section;
+    const char* key;
+    unsigned long long ProtocolStats::* counter;
+    float ProtocolRates::* rate; // nullptr for gauges
+} protocol_fields[] = {
+    {"Tcp", "ActiveOpens", &ProtocolStats::tcp_active_opens, &ProtocolRates::tcp_active_opens},
+    {"Tcp", "PassiveOpens", &ProtocolStats::tcp_passive_opens, &ProtocolRates::tcp_passive_opens},
+    {"Tcp", "AttemptFails", &ProtocolStats::tcp_attempt_fails, &ProtocolRates::tcp_attempt_fails},
+    {"Tcp", "EstabResets", &ProtocolStats::tcp_estab_resets, &ProtocolRates::tcp_estab_resets},
+    {"Tcp", "CurrEstab", &ProtocolStats::tcp_curr_estab, nullptr},
+    {"Tcp", "InSegs", &ProtocolStats::tcp_in_segs, &ProtocolRates::tcp_in_segs},
+    {"Tcp", "OutSegs", &ProtocolStats::tcp_out_segs, &ProtocolRates::tcp_out_segs},
+    {"Tcp", "RetransSegs", &ProtocolStats::tcp_retrans_segs, &ProtocolRates::tcp_retrans_segs},
+    {"Tcp", "InErrs", &ProtocolStats::tcp_in_errs, &ProtocolRates::tcp_in_errs},
+    {"Tcp", "OutRsts", &ProtocolStats::tcp_out_rsts, &ProtocolRates::tcp_out_rsts},
+    {"Tcp", "InCsumErrors", &ProtocolStats::tcp_in_csum_errors, &ProtocolRates::tcp_in_csum_errors},
+    {"Udp", "InDatagrams", &ProtocolStats::udp_in_datagrams, &ProtocolRates::udp_in_datagrams},
+    {"Udp", "NoPorts", &ProtocolStats::udp_no_ports, &ProtocolRates::udp_no_ports},
+    {"Udp", "InErrors", &ProtocolStats::udp_in_errors, &ProtocolRates::udp_in_errors},
+    {"Udp", "OutDatagrams", &ProtocolStats::udp_out_datagrams, &ProtocolRates::udp_out_datagrams},
+    {"Udp", "RcvbufErrors", &ProtocolStats::udp_rcvbuf_errors, &ProtocolRates::udp_rcvbuf_errors},
+    {"Udp", "SndbufErrors", &ProtocolStats::udp_sndbuf_errors, &ProtocolRates::udp_sndbuf_errors},
+    {"TcpExt", "ListenOverflows", &ProtocolStats::listen_overflows, &ProtocolRates::listen_overflows},
+    {"TcpExt", "ListenDrops", &ProtocolStats::listen_drops, &ProtocolRates::listen_drops},
+    {"TcpExt", "SyncookiesSent", &ProtocolStats::syncookies_sent, &ProtocolRates::syncookies_sent},
+    {"TcpExt", "TCPTimeouts", &ProtocolStats::tcp_timeouts, &ProtocolRates::tcp_timeouts},
+    {"TcpExt", "TCPSynRetrans", &ProtocolStats::tcp_syn_retrans, &ProtocolRates::tcp_syn_retrans},
+    {"TcpExt", "TCPFastRetrans", &ProtocolStats::tcp_fast_retrans, &ProtocolRates::tcp_fast_retrans},
+    {"TcpExt", "TCPLostRetransmit", &ProtocolStats::tcp_lost_retransmit, &ProtocolRates::tcp_lost_retransmit},
+    {"TcpExt", "TCPAbortOnTimeout", &ProtocolStats::tcp_abort_on_timeout, &ProtocolRates::tcp_abort_on_timeout},
+    {"TcpExt", "TCPAbortOnMemory", &ProtocolStats::tcp_abort_on_memory, &ProtocolRates::tcp_abort_on_memory},
+    {"TcpExt", "TCPBacklogDrop", &ProtocolStats::tcp_backlog_drop, &ProtocolRates::tcp_backlog_drop},
+};
+
+// Column layout of one section, e.g. "Tcp:", as last seen in its header line
+struct CounterSection {
+    std::string header;
+    std::vector<unsigned long long ProtocolStats::*> columns; // nullptr for columns we skip
+};
+
+// Only the protocol sampling task reads these files
+static std::map<std::string, CounterSection> counter_sections;
+
+static bool readSmallFile(const char* path, std::string& content) {
+    content.clear();
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    char buffer[8192];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        content.append(buffer, n);
+    }
+    close(fd);
+    return !content.empty();
+}
+
+static void mapSection(CounterSection& section, const std::string& name, const char* header, size_t length) {
+    section.header.assign(header, length);
+    section.columns.clear();
+
+    std::istringstream names(section.header);
+    std::string column;
+    names >> column; // the "Tcp:" prefix
+    while (names >> column) {
+        unsigned long long ProtocolStats::* counter = nullptr;
+        for (const auto& f : protocol_fields) {
+            if (name == f.section && column == f.key) {
+                counter = f.counter;
+                break;
+            }
+        }
+        section.columns.push_back(counter);
+    }
+}
+
+static void readCounterPairs(const std::string& content, ProtocolStats& stats) {
+    for (size_t start = 0; start < content.size(); ) {
+        size_t header_end = content.find('\n', start);
+        if (header_end == std::string::npos) break;
+        size_t values_end = content.find('\n', header_end + 1);
+        if (values_end == std::string::npos) values_end = content.size();
+
+        const char* header = content.c_str() + start;
+        size_t header_length = header_end - start;
+        const char* colon = (const char*)memchr(header, ':', header_length);
+        start = values_end + 1;
+        if (!colon) continue;
+
+        std::string name(header, colon - header);
+        CounterSection& section = counter_sections[name];
+        if (section.header.size() != header_length || memcmp(section.header.data(), header, header_length) != 0) {
+            mapSection(section, name, header, header_length);
+        }
+
+        // Values follow the prefix in header order
+        const char* value = content.c_str() + header_end + 1 + (colon - header) + 1;
+        for (auto counter : section.columns) {
+            char* next;
+            unsigned long long number = strtoull(value, &next, 10);
+            if (next == value) break;
+            if (counter) stats.*counter = number;
+            value = next;
+        }
+    }
+}
+
+// "TCP: inuse 5 orphan 0 tw 2 alloc 7 mem 1" and "UDP: inuse 1 mem 0"
+static void readSockstat(const std::string& content, ProtocolStats& stats) {
+    std::istringstream lines(content);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream iss(line);
+        std::string protocol, key;
+        unsigned long value;
+        iss >> protocol;
+        if (protocol != "TCP:" && protocol != "UDP:") continue;
+        bool tcp = protocol == "TCP:";
+        while (iss >> key >> value) {
+            if (key == "inuse") (tcp ? stats.tcp_in_use : stats.udp_in_use) = value;
+            else if (key == "mem") (tcp ? stats.tcp_mem_pages : stats.udp_mem_pages) = value;
+            else if (tcp && key == "orphan") stats.tcp_orphans = value;
+            else if (tcp && key == "tw") stats.tcp_time_wait = value;
+        }
+    }
+}
+
+bool readProtocolStats(ProtocolStats& stats) {
+    stats = ProtocolStats();
+
+    std::string content;
+    if (!readSmallFile("/proc/net/snmp", content)) return false;
+    readCounterPairs(content, stats);
+    // TcpExt is missing from some containers; the snmp counters still stand
+    if (readSmallFile("/proc/net/netstat", content)) readCounterPairs(content, stats);
+    if (readSmallFile("/proc/net/sockstat", content)) readSockstat(content, stats);
+    return true;
+}
+
+ProtocolRates protocolRatesBetween(const ProtocolStats& prev, const ProtocolStats& curr, float seconds) {
+    ProtocolRates rates;
+    if (seconds <= 0.0f) return rates;
+
+    for (const auto& f : protocol_fields) {
+        if (!f.rate) continue;
+        // A counter going backwards means it was reset; report no activity
+        unsigned long long before = prev.*f.counter;
+        unsigned long long after = curr.*f.counter;
+        rates.*f.rate = after >= before ? (after - before) / seconds : 0.0f;
+    }
+    if (rates.tcp_out_segs > 0.0f) {
+        rates.retransmit_percent = std::min(100.0f, 100.0f * rates.tcp_retrans_segs / rates.tcp_out_segs);
+    }
+    return rates;
+}
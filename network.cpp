@@ -2,8 +2,68 @@
 #include <ifaddrs.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <net/if.h>
+#include <unordered_map>
 
-std::vector<NetworkInterface> getNetworkInfo() {
+// Negotiated speed in Mb/s; virtual links and links that are down report -1 or fail to read
+int readLinkSpeed(const std::string& name) {
+    std::ifstream speed_file("/sys/class/net/" + name + "/speed");
+    int speed = 0;
+    if (!(speed_file >> speed) || speed < 0) return 0;
+    return speed;
+}
+
+std::string interfaceGroup(const std::string& kind, bool loopback, int peer_netns) {
+    if (loopback) return "loopback";
+    // Hardware NICs are the only links without a kind
+    if (kind.empty()) return "physical";
+    if (kind == "veth") return peer_netns >= 0 ? "veth netns " + std::to_string(peer_netns) : "veth";
+    if (kind == "macvlan" || kind == "macvtap" || kind == "ipvlan") return "macvlan";
+    const char* tunnels[] = {"tun", "vxlan", "geneve", "gre", "gretap", "ip6gre", "ipip", "sit", "ip6tnl", "wireguard"};
+    for (const char* tunnel : tunnels) {
+        if (kind == tunnel) return "tunnel";
+    }
+    return kind; // bond, bridge, vlan, dummy, ...
+}
+
+// The text path has no link kind; sysfs tells the common ones apart
+static std::string sysfsInterfaceGroup(const std::string& name) {
+    std::string dir = "/sys/class/net/" + name;
+    if (name == "lo") return interfaceGroup("", true, -1);
+    if (access((dir + "/bridge").c_str(), F_OK) == 0) return interfaceGroup("bridge", false, -1);
+    if (access((dir + "/bonding").c_str(), F_OK) == 0) return interfaceGroup("bond", false, -1);
+    if (access((dir + "/tun_flags").c_str(), F_OK) == 0) return interfaceGroup("tun", false, -1);
+    if (access((dir + "/device").c_str(), F_OK) == 0) return interfaceGroup("", false, -1);
+    
+    std::ifstream uevent(dir + "/uevent");
+    std::string line;
+    while (std::getline(uevent, line)) {
+        if (line.compare(0, 8, "DEVTYPE=") == 0) return interfaceGroup(line.substr(8), false, -1);
+    }
+    return "virtual";
+}
+
+std::vector<InterfaceGroupStats> summarizeInterfaceGroups(const std::vector<NetworkInterface>& interfaces) {
+    std::map<std::string, InterfaceGroupStats> groups;
+    for (const NetworkInterface& iface : interfaces) {
+        InterfaceGroupStats& group = groups[iface.group];
+        group.name = iface.group;
+        group.interfaces++;
+        group.rx_bytes_rate += iface.rx_bytes_rate;
+        group.tx_bytes_rate += iface.tx_bytes_rate;
+        group.rx_packets_rate += iface.rx_packets_rate;
+        group.tx_packets_rate += iface.tx_packets_rate;
+        group.errs_rate += iface.rx_errs_rate + iface.tx_errs_rate;
+        group.drop_rate += iface.rx_drop_rate + iface.tx_drop_rate;
+    }
+    
+    std::vector<InterfaceGroupStats> result;
+    for (const auto& entry : groups) result.push_back(entry.second);
+    return result;
+}
+
+// The text path, used where netlink is unavailable
+std::vector<NetworkInterface> getNetworkInfoFromProc() {
     std::vector<NetworkInterface> interfaces;
     
     // Read network statistics from /proc/net/dev
@@ -17,12 +77,17 @@ std::vector<NetworkInterface> getNetworkInfo() {
     
     // Get IP addresses for interfaces
     std::map<std::string, std::string> ip_addresses;
+    std::map<std::string, std::string> ipv6_addresses;
     struct ifaddrs *ifaddr, *ifa;
     if (getifaddrs(&ifaddr) != -1) {
         for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next) {
             if (ifa->ifa_addr && ifa->ifa_addr->sa_family == AF_INET) {
                 struct sockaddr_in* addr_in = (struct sockaddr_in*)ifa->ifa_addr;
                 ip_addresses[ifa->ifa_name] = inet_ntoa(addr_in->sin_addr);
+            } else if (ifa->ifa_addr && ifa->ifa_addr->sa_family == AF_INET6 && !ipv6_addresses.count(ifa->ifa_name)) {
+                char text[INET6_ADDRSTRLEN];
+                struct sockaddr_in6* addr_in6 = (struct sockaddr_in6*)ifa->ifa_addr;
+                if (inet_ntop(AF_INET6, &addr_in6->sin6_addr, text, sizeof(text))) ipv6_addresses[ifa->ifa_name] = text;
             }
         }
         freeifaddrs(ifaddr);
@@ -50,6 +115,10 @@ std::vector<NetworkInterface> getNetworkInfo() {
             continue;
         }
         
+        iface.link_speed_mbps = readLinkSpeed(iface.name);
+        iface.ifindex = (int)if_nametoindex(iface.name.c_str());
+        iface.group = sysfsInterfaceGroup(iface.name);
+        
         // Set IP address if available
         auto ip_it = ip_addresses.find(iface.name);
         if (ip_it != ip_addresses.end()) {
@@ -57,6 +126,8 @@ std::vector<NetworkInterface> getNetworkInfo() {
         } else {
             iface.ipv4_address = "N/A";
         }
+        auto ipv6_it = ipv6_addresses.find(iface.name);
+        if (ipv6_it != ipv6_addresses.end()) iface.ipv6_address = ipv6_it->second;
         
         interfaces.push_back(iface);
     }
@@ -64,26 +135,73 @@ std::vector<NetworkInterface> getNetworkInfo() {
     return interfaces;
 }
 
+// Both collectors report 64-bit counters, so a counter going backwards was
+// reset (the driver cleared its statistics); everything since then is new
+static unsigned long counterDelta(unsigned long before, unsigned long after) {
+    return after >= before ? after - before : after;
+}
+
+void updateInterfaceRates(const std::vector<NetworkInterface>& prev, std::vector<NetworkInterface>& curr, float seconds) {
+    if (seconds <= 0.0f) return;
+    std::unordered_map<std::string, const NetworkInterface*> prev_by_name;
+    prev_by_name.reserve(prev.size());
+    for (const NetworkInterface& iface : prev) prev_by_name.emplace(iface.name, &iface);
+
+    for (NetworkInterface& iface : curr) {
+        auto found = prev_by_name.find(iface.name);
+        if (found == prev_by_name.end()) continue; // new interface, rates from the next sample
+        const NetworkInterface* before = found->second;
+        // Deleted and created again under the same name: its counters start over
+        if (before->ifindex && iface.ifindex && before->ifindex != iface.ifindex) continue;
+        
+        iface.rx_bytes_rate = counterDelta(before->rx_bytes, iface.rx_bytes) / seconds;
+        iface.tx_bytes_rate = counterDelta(before->tx_bytes, iface.tx_bytes) / seconds;
+        iface.rx_packets_rate = counterDelta(before->rx_packets, iface.rx_packets) / seconds;
+        iface.tx_packets_rate = counterDelta(before->tx_packets, iface.tx_packets) / seconds;
+        iface.rx_errs_rate = counterDelta(before->rx_errs, iface.rx_errs) / seconds;
+        iface.tx_errs_rate = counterDelta(before->tx_errs, iface.tx_errs) / seconds;
+        iface.rx_drop_rate = counterDelta(before->rx_drop, iface.rx_drop) / seconds;
+        iface.tx_drop_rate = counterDelta(before->tx_drop, iface.tx_drop) / seconds;
+    }
+}
+
+std::vector<NetworkInterface> getNetworkInfo() {
+    std::vector<NetworkInterface> interfaces;
+    if (readNetlinkInterfaces(interfaces)) return interfaces;
+    return getNetworkInfoFromProc();
+}
+
+// Times both collectors over the interfaces of the current namespace
+void benchmarkNetworkInfo(int rounds) {
+    std::vector<NetworkInterface> interfaces;
+    if (!readNetlinkInterfaces(interfaces)) {
+        printf("netlink collector unavailable\n");
+    }
+    
+    const struct { const char* name; std::function<size_t()> collect; } paths[] = {
+        {"/proc/net/dev + getifaddrs", [] { return getNetworkInfoFromProc().size(); }},
+        {"netlink RTM_GETSTATS", [&] { return readNetlinkInterfaces(interfaces) ? interfaces.size() : 0; }},
+    };
+    for (const auto& path : paths) {
+        size_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++) count = path.collect();
+        float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("%s: %zu interfaces, %.3f ms per refresh\n", path.name, count, ms / std::max(1, rounds));
+    }
+}
+
 std::string formatNetworkBytes(unsigned long bytes) {
-    const double KB = 1024.0;
-    const double MB = KB * 1024.0;
-    const double GB = MB * 1024.0;
+    const char* units[] = {"B", "KB", "MB", "GB", "TB", "PB"};
+    int unit_index = 0;
+    double size = bytes;
     
-    if (bytes >= GB) {
-        double gb = bytes / GB;
-        if (gb >= 10.0) return ""; // Too big, don't display
-        return std::to_string((int)(gb * 100) / 100.0) + " GB";
-    } else if (bytes >= MB) {
-        double mb = bytes / MB;
-        if (mb >= 1000.0) return ""; // Too big
-        return std::to_string((int)(mb * 100) / 100.0) + " MB";
-    } else if (bytes >= KB) {
-        double kb = bytes / KB;
-        if (kb >= 1000000.0) return ""; // Too big
-        if (kb < 0.01) return ""; // Too small
-        return std::to_string((int)(kb * 100) / 100.0) + " KB";
-    } else {
-        if (bytes == 0) return "0 B";
-        return std::to_string(bytes) + " B";
+    while (size >= 1024.0 && unit_index < 5) {
+        size /= 1024.0;
+        unit_index++;
     }
-}
\ No newline at end of file
+    
+    char text[32];
+    snprintf(text, sizeof(text), unit_index == 0 ? "%.0f %s" : "%.2f %s", size, units[unit_index]);
+    return text;
+}
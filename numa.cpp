@@ -0,0 +1,291 @@
+#include "header.h"
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Per-node memory comes from /sys/devices/system/node/node*/{meminfo,numastat},
+// per-node CPU from summing /proc/stat's per-CPU lines over each node's cpulist.
+#define NUMA_NODE_DIR "/sys/devices/system/node"
+
+// "0-3,8-11" -> {0,1,2,3,8,9,10,11}
+static std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream iss(list);
+    std::string range;
+    while (std::getline(iss, range, ',')) {
+        int first = 0, last = 0;
+        int fields = sscanf(range.c_str(), "%d-%d", &first, &last);
+        if (fields < 1) continue;
+        if (fields == 1) last = first;
+        for (int cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+// "Node 0 MemTotal:   4554488 kB"
+static void readNodeMeminfo(NumaNode& node) {
+    std::ifstream file(NUMA_NODE_DIR "/node" + std::to_string(node.id) + "/meminfo");
+    std::string line;
+    while (std::getline(file, line)) {
+        char key[64];
+        unsigned long value;
+        if (sscanf(line.c_str(), "Node %*d %63[^:]: %lu", key, &value) != 2) continue;
+        if (strcmp(key, "MemTotal") == 0) node.total_ram = value;
+        else if (strcmp(key, "MemFree") == 0) node.free_ram = value;
+        else if (strcmp(key, "FilePages") == 0) node.file_pages = value;
+        else if (strcmp(key, "AnonPages") == 0) node.anon_pages = value;
+    }
+    node.used_ram = node.total_ram > node.free_ram ? node.total_ram - node.free_ram : 0;
+}
+
+// numastat counts pages allocated on this node and where they were meant to go
+static void readNodeNumastat(NumaNode& node) {
+    std::ifstream file(NUMA_NODE_DIR "/node" + std::to_string(node.id) + "/numastat");
+    std::string key;
+    unsigned long value;
+    while (file >> key >> value) {
+        if (key == "numa_hit") node.numa_hit = value;
+        else if (key == "numa_miss") node.numa_miss = value;
+        else if (key == "numa_foreign") node.numa_foreign = value;
+        else if (key == "local_node") node.local_node = value;
+        else if (key == "other_node") node.other_node = value;
+    }
+}
+
+// Sums per-CPU times from /proc/stat into each node's cpu field
+static void readNodeCpuTimes(std::vector<NumaNode>& nodes, const std::vector<int>& cpu_node) {
+    for (NumaNode& node : nodes) {
+        node.cpu = CPUInfo();
+    }
+
+    std::ifstream stat_file("/proc/stat");
+    std::string line;
+    while (std::getline(stat_file, line)) {
+        if (line.compare(0, 3, "cpu") != 0) break;
+        if (!isdigit((unsigned char)line[3])) continue; // the all-CPU line
+        int cpu;
+        CPUInfo times = {};
+        if (sscanf(line.c_str(), "cpu%d %ld %ld %ld %ld %ld %ld %ld", &cpu, &times.user, &times.nice, &times.system,
+                   &times.idle, &times.iowait, &times.irq, &times.softirq) != 8) continue;
+        if (cpu < 0 || cpu >= (int)cpu_node.size() || cpu_node[cpu] < 0) continue;
+
+        CPUInfo& sum = nodes[cpu_node[cpu]].cpu;
+        sum.user += times.user;
+        sum.nice += times.nice;
+        sum.system += times.system;
+        sum.idle += times.idle;
+        sum.iowait += times.iowait;
+        sum.irq += times.irq;
+        sum.softirq += times.softirq;
+    }
+}
+
+// Maps CPU number to index into nodes, -1 for CPUs in no node
+static std::vector<int> cpuToNode(const std::vector<NumaNode>& nodes) {
+    std::vector<int> cpu_node;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        for (int cpu : nodes[i].cpus) {
+            if (cpu >= (int)cpu_node.size()) cpu_node.resize(cpu + 1, -1);
+            cpu_node[cpu] = (int)i;
+        }
+    }
+    return cpu_node;
+}
+
+static std::vector<NumaNode> discoverNumaNodes() {
+    std::vector<NumaNode> nodes;
+    DIR* dir = opendir(NUMA_NODE_DIR);
+    if (!dir) return nodes;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        int id;
+        char extra;
+        if (sscanf(entry->d_name, "node%d%c", &id, &extra) != 1) continue;
+
+        NumaNode node;
+        node.id = id;
+        std::ifstream cpulist(NUMA_NODE_DIR "/" + std::string(entry->d_name) + "/cpulist");
+        std::string list;
+        std::getline(cpulist, list);
+        node.cpus = parseCpuList(list);
+        nodes.push_back(node);
+    }
+    closedir(dir);
+
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return nodes;
+}
+
+bool updateNumaNodes(std::vector<NumaNode>& nodes) {
+    // Node and CPU membership only change with hotplug; discover once
+    if (nodes.empty()) {
+        nodes = discoverNumaNodes();
+        if (nodes.empty()) return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<NumaNode> prev = nodes;
+    for (NumaNode& node : nodes) {
+        readNodeMeminfo(node);
+        readNodeNumastat(node);
+    }
+    readNodeCpuTimes(nodes, cpuToNode(nodes));
+
+    // Rates need a previous sample
+    for (size_t i = 0; i < nodes.size(); i++) {
+        NumaNode& node = nodes[i];
+        float seconds = std::chrono::duration<float>(now - node.sampled_at).count();
+        if (node.sampled_at.time_since_epoch().count() != 0 && seconds > 0.0f) {
+            node.cpu.usage_percent = cpuUsageBetween(prev[i].cpu, node.cpu);
+            node.numa_miss_rate = node.numa_miss >= prev[i].numa_miss ? (node.numa_miss - prev[i].numa_miss) / seconds : 0.0f;
+            node.other_node_rate = node.other_node >= prev[i].other_node ? (node.other_node - prev[i].other_node) / seconds : 0.0f;
+        }
+        node.sampled_at = now;
+    }
+    return true;
+}
+
+// Process placement from /proc/PID/numa_maps, read on a background thread because
+// walking a large process's mappings can take a long time.
+static std::mutex process_numa_mutex;
+static std::condition_variable process_numa_wakeup;
+static std::thread process_numa_thread;
+static bool process_numa_running = false;
+static std::vector<int> process_numa_wanted;
+static std::map<int, ProcessNuma> process_numa_results;
+
+#define PROCESS_NUMA_REFRESH_SECONDS 5
+
+// Lines look like "7f0c...000 default file=/usr/lib/libc.so.6 mapped=100 N0=60 N1=40 kernelpagesize_kB=4"
+static bool readProcessNuma(int pid, const std::vector<int>& cpu_node_ids, ProcessNuma& result) {
+    std::ifstream file("/proc/" + std::to_string(pid) + "/numa_maps");
+    if (!file.is_open()) return false;
+
+    result.node_kb.clear();
+    std::string line;
+    std::vector<std::pair<int, unsigned long>> pages;
+    while (std::getline(file, line)) {
+        pages.clear();
+        unsigned long page_kb = 4;
+        std::istringstream iss(line);
+        std::string token;
+        while (iss >> token) {
+            int node;
+            unsigned long count;
+            if (token[0] == 'N' && sscanf(token.c_str(), "N%d=%lu", &node, &count) == 2) {
+                pages.push_back({node, count});
+            } else if (token.compare(0, 18, "kernelpagesize_kB=") == 0) {
+                page_kb = strtoul(token.c_str() + 18, nullptr, 10);
+            }
+        }
+        for (const auto& p : pages) {
+            result.node_kb[p.first] += p.second * page_kb;
+        }
+    }
+
+    // The CPU the task last ran on decides which node counts as local
+    result.home_node = -1;
+    std::ifstream stat_file("/proc/" + std::to_string(pid) + "/stat");
+    std::string stat_line;
+    if (std::getline(stat_file, stat_line)) {
+        size_t close_paren = stat_line.rfind(')');
+        if (close_paren != std::string::npos) {
+            std::istringstream iss(stat_line.substr(close_paren + 2));
+            std::string field;
+            // Fields after the name start at 3 (state); processor is 39
+            for (int i = 3; i <= 39 && (iss >> field); i++) {
+                if (i == 39) {
+                    int cpu = atoi(field.c_str());
+                    if (cpu >= 0 && cpu < (int)cpu_node_ids.size()) result.home_node = cpu_node_ids[cpu];
+                }
+            }
+        }
+    }
+
+    unsigned long total = 0, remote = 0;
+    for (const auto& entry : result.node_kb) {
+        total += entry.second;
+        if (entry.first != result.home_node) remote += entry.second;
+    }
+    result.remote_percent = total > 0 && result.home_node >= 0 ? 100.0f * remote / total : 0.0f;
+    return true;
+}
+
+static void processNumaLoop() {
+    // CPU number -> node id, for finding each process's home node
+    std::vector<int> cpu_node_ids;
+    for (const NumaNode& node : discoverNumaNodes()) {
+        for (int cpu : node.cpus) {
+            if (cpu >= (int)cpu_node_ids.size()) cpu_node_ids.resize(cpu + 1, -1);
+            cpu_node_ids[cpu] = node.id;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(process_numa_mutex);
+    while (process_numa_running) {
+        // Refresh the stalest wanted process, if any is due
+        auto now = std::chrono::steady_clock::now();
+        int pid = -1;
+        for (int wanted : process_numa_wanted) {
+            auto it = process_numa_results.find(wanted);
+            if (it == process_numa_results.end() ||
+                now - it->second.sampled_at >= std::chrono::seconds(PROCESS_NUMA_REFRESH_SECONDS)) {
+                pid = wanted;
+                break;
+            }
+        }
+        if (pid < 0) {
+            process_numa_wakeup.wait_for(lock, std::chrono::seconds(1));
+            continue;
+        }
+
+        lock.unlock();
+        ProcessNuma result;
+        result.available = readProcessNuma(pid, cpu_node_ids, result);
+        result.sampled_at = std::chrono::steady_clock::now();
+        lock.lock();
+
+        process_numa_results[pid] = result;
+        requestRedraw();
+    }
+}
+
+void requestProcessNuma(const std::vector<int>& pids) {
+    std::lock_guard<std::mutex> lock(process_numa_mutex);
+    if (process_numa_wanted == pids && process_numa_running) return;
+
+    process_numa_wanted = pids;
+    for (auto it = process_numa_results.begin(); it != process_numa_results.end(); ) {
+        if (std::find(pids.begin(), pids.end(), it->first) == pids.end()) {
+            it = process_numa_results.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!process_numa_running && !pids.empty()) {
+        process_numa_running = true;
+        process_numa_thread = std::thread(processNumaLoop);
+    }
+    process_numa_wakeup.notify_all();
+}
+
+bool getProcessNuma(int pid, ProcessNuma& result) {
+    std::lock_guard<std::mutex> lock(process_numa_mutex);
+    auto it = process_numa_results.find(pid);
+    if (it == process_numa_results.end()) return false;
+    result = it->second;
+    return true;
+}
+
+void stopProcessNuma() {
+    {
+        std::lock_guard<std::mutex> lock(process_numa_mutex);
+        if (!process_numa_running) return;
+        process_numa_running = false;
+    }
+    process_numa_wakeup.notify_all();
+    if (process_numa_thread.joinable()) process_numa_thread.join();
+}
@@ -0,0 +1,78 @@
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "header.h"
+#include "imgui_internal.h"
+
+// Plots samples [begin, end) straight out of the ring, without copying them.
+// When there are more samples than pixel columns, each column draws the min/max
+// of its samples and joins the previous column's last sample to its first (M4),
+// so the draw list is bounded by the plot width and short spikes are never lost.
+void plotHistory(const char* id, const HistoryRing& history, unsigned long long begin, unsigned long long end,
+                 float scale_min, float scale_max, ImVec2 size, const char* overlay_text) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) return;
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    size = ImGui::CalcItemSize(size, ImGui::CalcItemWidth(), ImGui::GetFrameHeight());
+    const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + size);
+    const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
+    ImGui::ItemSize(frame_bb, style.FramePadding.y);
+    if (!ImGui::ItemAdd(frame_bb, window->GetID(id))) return;
+
+    ImGui::RenderFrame(frame_bb.Min, frame_bb.Max, ImGui::GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+    begin = std::max(begin, historyOldest(history));
+    unsigned long long count = end > begin ? end - begin : 0;
+    int columns = (int)inner_bb.GetWidth();
+
+    ImDrawList* draw_list = window->DrawList;
+    const ImU32 color = ImGui::GetColorU32(ImGuiCol_PlotLines);
+    const float inv_scale = scale_max != scale_min ? 1.0f / (scale_max - scale_min) : 0.0f;
+    auto toY = [&](float value) {
+        return inner_bb.Max.y - ImSaturate((value - scale_min) * inv_scale) * inner_bb.GetHeight();
+    };
+
+    if (count >= 2 && columns > 0) {
+        if (count <= (unsigned long long)columns) {
+            // Fewer samples than pixels: one vertex per sample
+            float step = inner_bb.GetWidth() / (float)(count - 1);
+            ImVec2 prev(inner_bb.Min.x, toY(historyAt(history, begin)));
+            for (unsigned long long i = 1; i < count; i++) {
+                ImVec2 point(inner_bb.Min.x + step * i, toY(historyAt(history, begin + i)));
+                draw_list->AddLine(prev, point, color);
+                prev = point;
+            }
+        } else {
+            float prev_y = 0.0f;
+            for (int column = 0; column < columns; column++) {
+                unsigned long long first = begin + count * column / columns;
+                unsigned long long last = begin + count * (column + 1) / columns;
+
+                float first_value = historyAt(history, first);
+                float last_value = first_value;
+                float low = first_value;
+                float high = first_value;
+                for (unsigned long long i = first + 1; i < last; i++) {
+                    last_value = historyAt(history, i);
+                    low = std::min(low, last_value);
+                    high = std::max(high, last_value);
+                }
+
+                float x = inner_bb.Min.x + column;
+                if (column > 0) draw_list->AddLine(ImVec2(x - 1.0f, prev_y), ImVec2(x, toY(first_value)), color);
+                if (high > low) draw_list->AddLine(ImVec2(x, toY(high)), ImVec2(x, toY(low)), color);
+                prev_y = toY(last_value);
+            }
+        }
+
+        if (ImGui::IsItemHovered() && inner_bb.Contains(ImGui::GetIO().MousePos)) {
+            float t = (ImGui::GetIO().MousePos.x - inner_bb.Min.x) / inner_bb.GetWidth();
+            unsigned long long index = begin + std::min(count - 1, (unsigned long long)(t * count));
+            ImGui::SetTooltip("%llu: %8.4g", index, historyAt(history, index));
+        }
+    }
+
+    if (overlay_text) {
+        ImGui::RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max,
+                                 overlay_text, nullptr, nullptr, ImVec2(0.5f, 0.0f));
+    }
+}
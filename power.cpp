@@ -0,0 +1,254 @@
+#include "header.h"
+#include <cstring>
+#include <mutex>
+#include <fcntl.h>
+#include <unordered_map>
+
+// RAPL energy counters from /sys/class/powercap. Each zone directory holds
+//   name                 "package-0", "core", "uncore", "dram" or "psys"
+//   energy_uj            microjoules since an arbitrary start, wrapping at
+//   max_energy_range_uj
+// Zones are found once and their energy_uj stays open. The root can point at a
+// copy of that layout (--powercap-root) to run without RAPL hardware.
+#define POWERCAP_DEFAULT_ROOT "/sys/class/powercap"
+#define CPU_TOPOLOGY_DIR "/sys/devices/system/cpu"
+
+struct TrackedDomain {
+    PowerDomain domain;
+    int fd = -1;
+};
+
+static std::mutex power_mutex;
+static std::string powercap_root = POWERCAP_DEFAULT_ROOT;
+static std::vector<TrackedDomain> tracked_domains;
+static bool domains_scanned = false;
+
+// Per-process CPU time at the previous estimate
+struct ProcessTicks {
+    unsigned long long start_time = 0;
+    unsigned long long ticks = 0;
+    double joules = 0.0;
+};
+
+// Busy CPU ticks keyed by package id; ALL_PACKAGES sums every CPU
+#define ALL_PACKAGES -1
+
+static std::unordered_map<int, ProcessTicks> process_ticks;
+static std::vector<int> cpu_packages; // CPU number -> physical package id, -1 unknown
+static bool cpu_packages_read = false;
+static std::map<int, unsigned long long> energy_prev_busy;
+static std::chrono::steady_clock::time_point energy_prev_time;
+static bool energy_has_prev = false;
+
+static std::string readZoneLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return trim(line);
+}
+
+void setPowercapRoot(const std::string& root) {
+    std::lock_guard<std::mutex> lock(power_mutex);
+    powercap_root = root;
+    domains_scanned = false;
+}
+
+// "intel-rapl:0" and its subzones "intel-rapl:0:0"; the MMIO interface repeats
+// the package counter and is skipped so it is not counted twice
+static void scanDomains() {
+    for (TrackedDomain& tracked : tracked_domains) {
+        if (tracked.fd >= 0) close(tracked.fd);
+    }
+    tracked_domains.clear();
+    domains_scanned = true;
+
+    DIR* dir = opendir(powercap_root.c_str());
+    if (!dir) return;
+    std::vector<std::string> zones;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, "intel-rapl:", 11) == 0) zones.push_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(zones.begin(), zones.end());
+
+    for (const std::string& zone : zones) {
+        std::string zone_dir = powercap_root + "/" + zone;
+        TrackedDomain tracked;
+        tracked.domain.zone = zone;
+        tracked.domain.name = readZoneLine(zone_dir + "/name");
+        if (tracked.domain.name.empty()) continue;
+        tracked.domain.top_level = std::count(zone.begin(), zone.end(), ':') == 1;
+        std::string range = readZoneLine(zone_dir + "/max_energy_range_uj");
+        tracked.domain.max_energy_uj = strtoull(range.c_str(), nullptr, 10);
+        // energy_uj is root-only on kernels patched for PLATYPUS (CVE-2020-8694)
+        tracked.fd = open((zone_dir + "/energy_uj").c_str(), O_RDONLY | O_CLOEXEC);
+        tracked_domains.push_back(tracked);
+    }
+}
+
+bool readPowerDomains(std::vector<PowerDomain>& domains) {
+    std::lock_guard<std::mutex> lock(power_mutex);
+    if (!domains_scanned) scanDomains();
+
+    domains.clear();
+    for (TrackedDomain& tracked : tracked_domains) {
+        PowerDomain domain = tracked.domain;
+        char buffer[32];
+        ssize_t length = tracked.fd >= 0 ? pread(tracked.fd, buffer, sizeof(buffer) - 1, 0) : -1;
+        domain.readable = length > 0;
+        if (domain.readable) {
+            buffer[length] = '\0';
+            domain.energy_uj = strtoull(buffer, nullptr, 10);
+        }
+        domains.push_back(domain);
+    }
+    return !domains.empty();
+}
+
+void updatePowerRates(const std::vector<PowerDomain>& prev, std::vector<PowerDomain>& curr, float seconds) {
+    if (seconds <= 0.0f) return;
+    for (PowerDomain& domain : curr) {
+        auto before = std::find_if(prev.begin(), prev.end(), [&](const PowerDomain& d) { return d.zone == domain.zone; });
+        if (before == prev.end() || !before->readable || !domain.readable) continue;
+
+        // The counter restarts from zero after max_energy_range_uj
+        unsigned long long used;
+        if (domain.energy_uj >= before->energy_uj) {
+            used = domain.energy_uj - before->energy_uj;
+        } else if (domain.max_energy_uj > before->energy_uj) {
+            used = domain.max_energy_uj - before->energy_uj + domain.energy_uj;
+        } else {
+            continue; // no range to unwrap with
+        }
+        domain.watts = used / 1000000.0f / seconds;
+    }
+}
+
+// Packages cover cores and uncore; psys (the whole SoC) only when there are none
+float totalPackageWatts(const std::vector<PowerDomain>& domains) {
+    float package = 0.0f, psys = 0.0f;
+    bool has_package = false;
+    for (const PowerDomain& domain : domains) {
+        if (!domain.top_level || !domain.readable) continue;
+        if (domain.name.compare(0, 7, "package") == 0) {
+            package += domain.watts;
+            has_package = true;
+        } else if (domain.name == "psys") {
+            psys += domain.watts;
+        }
+    }
+    return has_package ? package : psys;
+}
+
+// cpuN/topology/physical_package_id for every CPU present
+static void readCpuPackages() {
+    cpu_packages_read = true;
+    DIR* dir = opendir(CPU_TOPOLOGY_DIR);
+    if (!dir) return;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        int cpu;
+        char extra;
+        if (sscanf(entry->d_name, "cpu%d%c", &cpu, &extra) != 1) continue;
+        std::string id = readZoneLine(CPU_TOPOLOGY_DIR "/" + std::string(entry->d_name) + "/topology/physical_package_id");
+        if (id.empty()) continue;
+        if (cpu >= (int)cpu_packages.size()) cpu_packages.resize(cpu + 1, -1);
+        cpu_packages[cpu] = atoi(id.c_str());
+    }
+    closedir(dir);
+}
+
+// Busy ticks per package from /proc/stat's per-CPU lines, and of all CPUs
+static bool readPackageBusy(std::map<int, unsigned long long>& busy) {
+    busy.clear();
+    std::ifstream stat_file("/proc/stat");
+    std::string line;
+    while (std::getline(stat_file, line)) {
+        if (line.compare(0, 3, "cpu") != 0) break;
+        int cpu = ALL_PACKAGES;
+        CPUInfo times = {};
+        bool all = !isdigit((unsigned char)line[3]);
+        int fields = all ? sscanf(line.c_str(), "cpu %ld %ld %ld %ld %ld %ld %ld", &times.user, &times.nice, &times.system,
+                                  &times.idle, &times.iowait, &times.irq, &times.softirq) + 1
+                         : sscanf(line.c_str(), "cpu%d %ld %ld %ld %ld %ld %ld %ld", &cpu, &times.user, &times.nice,
+                                  &times.system, &times.idle, &times.iowait, &times.irq, &times.softirq);
+        if (fields != 8) continue;
+        unsigned long long ticks = times.user + times.nice + times.system + times.irq + times.softirq;
+        if (all) {
+            busy[ALL_PACKAGES] = ticks;
+        } else if (cpu >= 0 && cpu < (int)cpu_packages.size() && cpu_packages[cpu] >= 0) {
+            busy[cpu_packages[cpu]] += ticks;
+        }
+    }
+    return busy.count(ALL_PACKAGES) > 0;
+}
+
+// RAPL has no per-process counters. Each package's power is split among the
+// processes that ran on its CPUs, by their share of that package's busy CPU
+// time since the last call; a process counts toward the package of the CPU it
+// last ran on. Without per-package readings (psys only, or CPUs with no
+// topology) the total is split over all busy CPU time instead. Idle and uncore
+// power are spread the same way, so this is an estimate.
+void updateProcessEnergy(const std::vector<ProcessInfo>& processes, const std::vector<PowerDomain>& domains,
+                         std::vector<ProcessEnergy>& result) {
+    std::lock_guard<std::mutex> lock(power_mutex);
+    result.clear();
+    if (!cpu_packages_read) readCpuPackages();
+    std::map<int, unsigned long long> busy;
+    if (!readPackageBusy(busy)) return;
+    auto now = std::chrono::steady_clock::now();
+
+    // "package-1" is the RAPL domain of physical package 1
+    std::map<int, float> package_watts;
+    for (const PowerDomain& domain : domains) {
+        if (domain.top_level && domain.readable && domain.name.compare(0, 8, "package-") == 0) {
+            package_watts[atoi(domain.name.c_str() + 8)] += domain.watts;
+        }
+    }
+    package_watts[ALL_PACKAGES] = totalPackageWatts(domains);
+
+    std::map<int, unsigned long long> busy_ticks;
+    for (const auto& entry : busy) {
+        auto before = energy_prev_busy.find(entry.first);
+        if (energy_has_prev && before != energy_prev_busy.end() && entry.second > before->second) {
+            busy_ticks[entry.first] = entry.second - before->second;
+        }
+    }
+    float seconds = std::chrono::duration<float>(now - energy_prev_time).count();
+    energy_prev_busy.swap(busy);
+    energy_prev_time = now;
+    bool has_interval = energy_has_prev && seconds > 0.0f;
+    energy_has_prev = true;
+
+    std::unordered_map<int, ProcessTicks> ticks;
+    ticks.reserve(processes.size());
+    for (const ProcessInfo& proc : processes) {
+        ProcessTicks& entry = ticks[proc.pid];
+        entry.start_time = proc.start_time;
+        entry.ticks = proc.cpu_ticks;
+
+        auto before = process_ticks.find(proc.pid);
+        if (before == process_ticks.end() || before->second.start_time != proc.start_time) continue;
+        entry.joules = before->second.joules;
+        if (!has_interval || proc.cpu_ticks <= before->second.ticks) continue;
+
+        int package = proc.processor >= 0 && proc.processor < (int)cpu_packages.size() ? cpu_packages[proc.processor] : -1;
+        if (package < 0 || !package_watts.count(package) || !busy_ticks.count(package)) package = ALL_PACKAGES;
+        if (!busy_ticks.count(package)) continue;
+
+        ProcessEnergy energy;
+        energy.pid = proc.pid;
+        energy.name = proc.name;
+        float share = std::min(1.0f, (float)(proc.cpu_ticks - before->second.ticks) / busy_ticks[package]);
+        energy.cpu_share_percent = share * 100.0f;
+        energy.watts = package_watts[package] * share;
+        entry.joules += energy.watts * seconds;
+        energy.joules = entry.joules;
+        result.push_back(energy);
+    }
+    // Exited processes drop out here
+    process_ticks.swap(ticks);
+
+    std::sort(result.begin(), result.end(), [](const ProcessEnergy& a, const ProcessEnergy& b) { return a.watts > b.watts; });
+}
@@ -0,0 +1,129 @@
+#include "header.h"
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <unordered_map>
+
+// Per-process I/O from /proc/PID/io. Reading it for every process on every tick
+// is too costly on hosts with tens of thousands of PIDs, so the heaviest I/O
+// users are read every tick and the rest in slices: each tick reads one
+// PROCESS_IO_SWEEP_SLICES-th of them, picked by PID. Rates are kept per PID with
+// their own timestamps, so a process read less often still gets a correct rate.
+#define PROCESS_IO_HOT 32
+#define PROCESS_IO_SWEEP_SLICES 5
+
+struct ProcessIoSample {
+    unsigned long long start_time = 0;
+    bool known = false;
+    unsigned long long read_bytes = 0;
+    unsigned long long write_bytes = 0;
+    unsigned long long cancelled_write_bytes = 0;
+    unsigned long long syscr = 0;
+    unsigned long long syscw = 0;
+    float read_rate = 0.0f;
+    float write_rate = 0.0f;
+    float syscall_rate = 0.0f;
+    std::chrono::steady_clock::time_point sampled_at;
+};
+
+// Shared by every caller of getProcesses(); each entry carries its own time
+static std::mutex process_io_mutex;
+static std::unordered_map<int, ProcessIoSample> process_io_cache;
+static std::vector<int> process_io_hot;
+static unsigned int process_io_slice = 0;
+
+// "rchar: 323934931\nwchar: 323929600\nsyscr: 632687\nsyscw: 632675\nread_bytes: 0\n..."
+static bool readProcessIo(int pid, ProcessIoSample& sample) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/io", pid);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    char buffer[512];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0) return false; // unreadable without ptrace access
+    buffer[length] = '\0';
+
+    for (char* line = buffer; line && *line; ) {
+        char* colon = strchr(line, ':');
+        if (!colon) break;
+        unsigned long long value = strtoull(colon + 1, nullptr, 10);
+        size_t key_length = colon - line;
+        if (key_length == 5 && strncmp(line, "syscr", 5) == 0) sample.syscr = value;
+        else if (key_length == 5 && strncmp(line, "syscw", 5) == 0) sample.syscw = value;
+        else if (key_length == 10 && strncmp(line, "read_bytes", 10) == 0) sample.read_bytes = value;
+        else if (key_length == 11 && strncmp(line, "write_bytes", 11) == 0) sample.write_bytes = value;
+        else if (key_length == 21 && strncmp(line, "cancelled_write_bytes", 21) == 0) sample.cancelled_write_bytes = value;
+        line = strchr(colon, '\n');
+        if (line) line++;
+    }
+    return true;
+}
+
+static void refreshProcessIo(int pid, ProcessIoSample& entry, unsigned long long start_time,
+                             std::chrono::steady_clock::time_point now) {
+    ProcessIoSample sample;
+    sample.start_time = start_time;
+    sample.sampled_at = now;
+    sample.known = readProcessIo(pid, sample);
+
+    // Rates need an earlier sample of the same process, not a reused PID
+    float seconds = std::chrono::duration<float>(now - entry.sampled_at).count();
+    if (sample.known && entry.known && entry.start_time == start_time && seconds > 0.0f) {
+        auto delta = [](unsigned long long before, unsigned long long after) { return after >= before ? after - before : 0ULL; };
+        // Writes truncated away before reaching storage never cost any I/O
+        unsigned long long written = delta(entry.write_bytes, sample.write_bytes);
+        unsigned long long cancelled = delta(entry.cancelled_write_bytes, sample.cancelled_write_bytes);
+        sample.read_rate = delta(entry.read_bytes, sample.read_bytes) / seconds;
+        sample.write_rate = (written > cancelled ? written - cancelled : 0) / seconds;
+        sample.syscall_rate = (delta(entry.syscr, sample.syscr) + delta(entry.syscw, sample.syscw)) / seconds;
+    }
+    entry = sample;
+}
+
+void updateProcessIo(std::vector<ProcessInfo>& processes) {
+    std::lock_guard<std::mutex> lock(process_io_mutex);
+    auto now = std::chrono::steady_clock::now();
+    unsigned int slice = process_io_slice++ % PROCESS_IO_SWEEP_SLICES;
+
+    std::unordered_map<int, ProcessIoSample> cache;
+    cache.reserve(processes.size());
+    for (ProcessInfo& proc : processes) {
+        auto it = process_io_cache.find(proc.pid);
+        bool cached = it != process_io_cache.end() && it->second.start_time == proc.start_time;
+        ProcessIoSample& entry = cache[proc.pid];
+        if (it != process_io_cache.end()) entry = it->second;
+
+        // New processes get a baseline now; known ones wait for their turn
+        bool hot = std::find(process_io_hot.begin(), process_io_hot.end(), proc.pid) != process_io_hot.end();
+        if (!cached || hot || (unsigned int)proc.pid % PROCESS_IO_SWEEP_SLICES == slice) {
+            refreshProcessIo(proc.pid, entry, proc.start_time, now);
+        }
+
+        proc.io_known = entry.known;
+        proc.io_read_bytes = entry.read_bytes;
+        proc.io_write_bytes = entry.write_bytes;
+        proc.io_cancelled_write_bytes = entry.cancelled_write_bytes;
+        proc.io_syscr = entry.syscr;
+        proc.io_syscw = entry.syscw;
+        proc.io_read_rate = entry.read_rate;
+        proc.io_write_rate = entry.write_rate;
+        proc.io_syscall_rate = entry.syscall_rate;
+    }
+    // Exited processes drop out here
+    process_io_cache.swap(cache);
+
+    // Busiest processes are read at full rate next time
+    std::vector<std::pair<float, int>> busy;
+    for (const auto& entry : process_io_cache) {
+        float rate = entry.second.read_rate + entry.second.write_rate;
+        if (rate > 0.0f) busy.push_back({rate, entry.first});
+    }
+    size_t hot_count = std::min(busy.size(), (size_t)PROCESS_IO_HOT);
+    std::partial_sort(busy.begin(), busy.begin() + hot_count, busy.end(), std::greater<std::pair<float, int>>());
+    process_io_hot.clear();
+    for (size_t i = 0; i < hot_count; i++) {
+        process_io_hot.push_back(busy[i].second);
+    }
+}
@@ -0,0 +1,61 @@
+#include "header.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+// One sampling thread feeds every snapshot consumer (exporter, agent, shared memory),
+// so adding consumers never adds /proc scans.
+static std::atomic<bool> sampler_running(false);
+static std::thread sampler_thread;
+static std::mutex sampler_mutex;
+static std::condition_variable sampler_wakeup;
+static std::vector<SnapshotListener> sampler_listeners;
+
+static void samplerLoop(SamplerSettings settings) {
+    CPUInfo prev_cpu = {};
+    auto interval = std::chrono::milliseconds((long)(settings.interval_seconds * 1000.0f));
+    auto next_sample = std::chrono::steady_clock::now();
+
+    while (sampler_running) {
+        MetricsSnapshot snapshot = collectMetricsSnapshot(prev_cpu, settings.top_processes);
+
+        std::unique_lock<std::mutex> lock(sampler_mutex);
+        for (const auto& listener : sampler_listeners) {
+            listener(snapshot);
+        }
+
+        next_sample += interval;
+        if (next_sample < std::chrono::steady_clock::now()) {
+            next_sample = std::chrono::steady_clock::now() + interval;
+        }
+        sampler_wakeup.wait_until(lock, next_sample, [] { return !sampler_running; });
+    }
+}
+
+void addSnapshotListener(const SnapshotListener& listener) {
+    std::lock_guard<std::mutex> lock(sampler_mutex);
+    sampler_listeners.push_back(listener);
+}
+
+bool startSampler(const SamplerSettings& settings) {
+    if (sampler_running) return false;
+
+    sampler_running = true;
+    sampler_thread = std::thread(samplerLoop, settings);
+    return true;
+}
+
+void stopSampler() {
+    if (!sampler_running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(sampler_mutex);
+        sampler_running = false;
+    }
+    sampler_wakeup.notify_all();
+    if (sampler_thread.joinable()) sampler_thread.join();
+
+    std::lock_guard<std::mutex> lock(sampler_mutex);
+    sampler_listeners.clear();
+}
@@ -0,0 +1,91 @@
+#include "header.h"
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+// Each periodic task runs on its own thread, woken by a timerfd armed against
+// CLOCK_MONOTONIC. The kernel keeps the period, so late wakeups never shift later
+// deadlines, and a slow task (a /proc scan) cannot delay a fast one (CPU at 100 Hz).
+struct PeriodicTask {
+    int timer_fd = -1;
+    std::function<void()> run;
+    std::thread thread;
+};
+
+static std::mutex scheduler_mutex;
+static std::vector<std::unique_ptr<PeriodicTask>> scheduler_tasks;
+static int scheduler_stop_fd = -1;
+
+static void armTimer(int timer_fd, float interval_seconds) {
+    itimerspec spec = {};
+    if (interval_seconds > 0.0f) {
+        long long ns = (long long)(interval_seconds * 1e9);
+        spec.it_interval.tv_sec = ns / 1000000000LL;
+        spec.it_interval.tv_nsec = ns % 1000000000LL;
+
+        // First deadline is now, so the first sample is taken right away
+        clock_gettime(CLOCK_MONOTONIC, &spec.it_value);
+    }
+    timerfd_settime(timer_fd, interval_seconds > 0.0f ? TFD_TIMER_ABSTIME : 0, &spec, nullptr);
+}
+
+static void taskLoop(PeriodicTask* task) {
+    pollfd fds[2] = {{task->timer_fd, POLLIN, 0}, {scheduler_stop_fd, POLLIN, 0}};
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) continue;
+        if (fds[1].revents) break;
+
+        // Missed expirations are folded into one run rather than replayed
+        uint64_t expirations;
+        if (read(task->timer_fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            task->run();
+        }
+    }
+}
+
+int addPeriodicTask(float interval_seconds, const std::function<void()>& run) {
+    std::lock_guard<std::mutex> lock(scheduler_mutex);
+    if (scheduler_stop_fd < 0) {
+        scheduler_stop_fd = eventfd(0, EFD_CLOEXEC);
+        if (scheduler_stop_fd < 0) return -1;
+    }
+
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if (timer_fd < 0) return -1;
+
+    std::unique_ptr<PeriodicTask> task(new PeriodicTask);
+    task->timer_fd = timer_fd;
+    task->run = run;
+    armTimer(timer_fd, interval_seconds);
+    task->thread = std::thread(taskLoop, task.get());
+
+    scheduler_tasks.push_back(std::move(task));
+    return (int)scheduler_tasks.size() - 1;
+}
+
+void setPeriodicTaskInterval(int task, float interval_seconds) {
+    std::lock_guard<std::mutex> lock(scheduler_mutex);
+    if (task < 0 || task >= (int)scheduler_tasks.size()) return;
+    armTimer(scheduler_tasks[task]->timer_fd, interval_seconds);
+}
+
+void stopScheduler() {
+    std::lock_guard<std::mutex> lock(scheduler_mutex);
+    if (scheduler_stop_fd < 0) return;
+
+    uint64_t one = 1;
+    if (write(scheduler_stop_fd, &one, sizeof(one)) < 0) {
+        // The stop counter is already set
+    }
+    for (auto& task : scheduler_tasks) {
+        if (task->thread.joinable()) task->thread.join();
+        close(task->timer_fd);
+    }
+    scheduler_tasks.clear();
+
+    close(scheduler_stop_fd);
+    scheduler_stop_fd = -1;
+}
@@ -0,0 +1,327 @@
+#include "header.h"
+#include <cstring>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+
+// Hardware sensors from /sys/class/thermal and /sys/class/hwmon. The sysfs tree
+// is walked once and every input file stays open; a sample is one pread() per
+// sensor. The tree is walked again only when a kernel uevent reports a hwmon or
+// thermal device coming or going. Where uevents cannot be received (no
+// permission), it is walked again every SENSOR_RESCAN_SECONDS instead.
+#define SENSOR_RESCAN_SECONDS 60
+
+struct TrackedSensor {
+    SensorReading reading;
+    int fd = -1;
+    float scale = 1.0f; // sysfs units per display unit
+    int pwm_fd = -1; // fan duty cycle, 0-255
+};
+
+// Channel prefixes hwmon uses, with sysfs units per display unit
+static const struct {
+    const char* prefix;
+    SensorKind kind;
+    float scale;
+} hwmon_channels[] = {
+    {"temp", SENSOR_TEMPERATURE, 1000.0f}, // millidegrees
+    {"fan", SENSOR_FAN, 1.0f},             // RPM
+    {"in", SENSOR_VOLTAGE, 1000.0f},       // millivolts
+    {"power", SENSOR_POWER, 1000000.0f},   // microwatts
+    {"curr", SENSOR_CURRENT, 1000.0f},     // milliamps
+};
+
+// Chips that measure the CPU itself, preferred for the headline temperature
+static const char* cpu_sensor_chips[] = {"coretemp", "k10temp", "zenpower", "x86_pkg_temp", "cpu_thermal", "cpu-thermal", "soc_thermal"};
+
+static std::mutex sensor_mutex;
+static std::vector<TrackedSensor> tracked_sensors;
+static bool sensors_scanned = false;
+static int uevent_fd = -1;
+static std::chrono::steady_clock::time_point sensors_scanned_at;
+// The headline sensors picked by the last full sweep, -1 for none
+static int headline_thermal = -1;
+static int headline_fan = -1;
+
+static std::string readSysfsLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return trim(line);
+}
+
+// Thresholds are read once at discovery; 0 when the file is missing
+static float readSysfsValue(const std::string& path, float scale) {
+    std::string text = readSysfsLine(path);
+    return text.empty() ? 0.0f : strtof(text.c_str(), nullptr) / scale;
+}
+
+static void closeSensors() {
+    for (TrackedSensor& sensor : tracked_sensors) {
+        if (sensor.fd >= 0) close(sensor.fd);
+        if (sensor.pwm_fd >= 0) close(sensor.pwm_fd);
+    }
+    tracked_sensors.clear();
+}
+
+// thermal_zoneN/temp, with the "critical" trip point as the limit
+static void scanThermalZones(std::vector<std::string>& zone_types) {
+    DIR* dir = opendir("/sys/class/thermal");
+    if (!dir) return;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, "thermal_zone", 12) != 0) continue;
+        std::string zone = std::string("/sys/class/thermal/") + entry->d_name;
+
+        TrackedSensor sensor;
+        sensor.fd = open((zone + "/temp").c_str(), O_RDONLY | O_CLOEXEC);
+        if (sensor.fd < 0) continue;
+        sensor.scale = 1000.0f;
+        sensor.reading.kind = SENSOR_TEMPERATURE;
+        sensor.reading.chip = readSysfsLine(zone + "/type");
+        sensor.reading.device = entry->d_name;
+        sensor.reading.label = entry->d_name;
+        zone_types.push_back(sensor.reading.chip);
+        for (int trip = 0; ; trip++) {
+            std::string prefix = zone + "/trip_point_" + std::to_string(trip);
+            std::string type = readSysfsLine(prefix + "_type");
+            if (type.empty()) break;
+            if (type == "critical") sensor.reading.critical = readSysfsValue(prefix + "_temp", 1000.0f);
+        }
+        tracked_sensors.push_back(sensor);
+    }
+    closedir(dir);
+}
+
+// hwmonN/<prefix><n>_input with _label, _crit (or _max) and _min beside it
+static void scanHwmon(const std::vector<std::string>& zone_types) {
+    DIR* dir = opendir("/sys/class/hwmon");
+    if (!dir) return;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.') continue;
+        std::string chip_dir = std::string("/sys/class/hwmon/") + entry->d_name;
+        bool has_device = access((chip_dir + "/device").c_str(), F_OK) == 0;
+        // Older drivers keep their attributes under device/
+        if (access((chip_dir + "/name").c_str(), F_OK) != 0 && has_device) chip_dir += "/device";
+        std::string chip = readSysfsLine(chip_dir + "/name");
+
+        // Thermal zones register a device-less hwmon twin named after the zone
+        if (!has_device && std::find(zone_types.begin(), zone_types.end(), chip) != zone_types.end()) continue;
+
+        DIR* chip_entries = opendir(chip_dir.c_str());
+        if (!chip_entries) continue;
+        std::vector<std::string> inputs;
+        struct dirent* file;
+        while ((file = readdir(chip_entries)) != nullptr) {
+            size_t length = strlen(file->d_name);
+            if (length > 6 && strcmp(file->d_name + length - 6, "_input") == 0) inputs.push_back(file->d_name);
+        }
+        closedir(chip_entries);
+        std::sort(inputs.begin(), inputs.end());
+
+        for (const std::string& input : inputs) {
+            std::string channel = input.substr(0, input.size() - 6); // "temp1"
+            for (const auto& type : hwmon_channels) {
+                size_t prefix_length = strlen(type.prefix);
+                if (channel.compare(0, prefix_length, type.prefix) != 0 || !isdigit((unsigned char)channel[prefix_length])) continue;
+
+                TrackedSensor sensor;
+                std::string base = chip_dir + "/" + channel;
+                sensor.fd = open((base + "_input").c_str(), O_RDONLY | O_CLOEXEC);
+                if (sensor.fd < 0) break;
+                sensor.scale = type.scale;
+                sensor.reading.kind = type.kind;
+                sensor.reading.chip = chip.empty() ? entry->d_name : chip;
+                sensor.reading.device = entry->d_name;
+                sensor.reading.label = readSysfsLine(base + "_label");
+                if (sensor.reading.label.empty()) sensor.reading.label = channel;
+                sensor.reading.critical = readSysfsValue(base + "_crit", type.scale);
+                if (sensor.reading.critical == 0.0f) sensor.reading.critical = readSysfsValue(base + "_max", type.scale);
+                sensor.reading.minimum = readSysfsValue(base + "_min", type.scale);
+                if (type.kind == SENSOR_FAN) {
+                    sensor.pwm_fd = open((chip_dir + "/pwm" + channel.substr(prefix_length)).c_str(), O_RDONLY | O_CLOEXEC);
+                }
+                tracked_sensors.push_back(sensor);
+                break;
+            }
+        }
+    }
+    closedir(dir);
+}
+
+static void scanSensors() {
+    closeSensors();
+    std::vector<std::string> zone_types;
+    scanThermalZones(zone_types);
+    scanHwmon(zone_types);
+    sensors_scanned = true;
+    sensors_scanned_at = std::chrono::steady_clock::now();
+    headline_thermal = -1;
+    headline_fan = -1;
+}
+
+static void openUeventSocket() {
+    uevent_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (uevent_fd < 0) return;
+    sockaddr_nl address = {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = 1; // kernel events
+    if (bind(uevent_fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        close(uevent_fd);
+        uevent_fd = -1;
+    }
+}
+
+// Drains pending uevents; true if any was about a sensor device
+static bool sensorsHotplugged() {
+    if (uevent_fd < 0) {
+        return std::chrono::steady_clock::now() - sensors_scanned_at >= std::chrono::seconds(SENSOR_RESCAN_SECONDS);
+    }
+    bool changed = false;
+    char buffer[8192];
+    ssize_t length;
+    while ((length = recv(uevent_fd, buffer, sizeof(buffer) - 1, 0)) > 0) {
+        // "add@/devices/...\0ACTION=add\0...\0SUBSYSTEM=hwmon\0..."
+        buffer[length] = '\0';
+        for (const char* field = buffer; field < buffer + length; field += strlen(field) + 1) {
+            if (strcmp(field, "SUBSYSTEM=hwmon") == 0 || strcmp(field, "SUBSYSTEM=thermal") == 0) changed = true;
+        }
+    }
+    return changed;
+}
+
+static bool readSensorFile(int fd, float& value) {
+    char buffer[32];
+    ssize_t length = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0) return false; // gone, or the chip refused (asleep, I2C error)
+    buffer[length] = '\0';
+    value = strtof(buffer, nullptr);
+    return true;
+}
+
+static void refreshSensor(TrackedSensor& sensor) {
+    float raw;
+    sensor.reading.valid = readSensorFile(sensor.fd, raw);
+    sensor.reading.value = sensor.reading.valid ? raw / sensor.scale : 0.0f;
+    float duty;
+    sensor.reading.duty_percent = sensor.pwm_fd >= 0 && readSensorFile(sensor.pwm_fd, duty) ? (int)(duty * 100.0f / 255.0f) : -1;
+}
+
+static bool isCpuSensor(const SensorReading& sensor) {
+    return std::find_if(std::begin(cpu_sensor_chips), std::end(cpu_sensor_chips), [&](const char* chip) {
+        return sensor.chip == chip;
+    }) != std::end(cpu_sensor_chips);
+}
+
+// A CPU sensor if there is one, else the hottest
+static int thermalSensorIndex(const std::vector<SensorReading>& sensors) {
+    int best = -1, best_rank = -1;
+    for (size_t i = 0; i < sensors.size(); i++) {
+        const SensorReading& sensor = sensors[i];
+        if (sensor.kind != SENSOR_TEMPERATURE || !sensor.valid) continue;
+        int rank = isCpuSensor(sensor) ? 1 : 0;
+        if (rank > best_rank || (rank == best_rank && sensor.value > sensors[best].value)) {
+            best = (int)i;
+            best_rank = rank;
+        }
+    }
+    return best;
+}
+
+// The fastest fan
+static int fanSensorIndex(const std::vector<SensorReading>& sensors) {
+    int best = -1;
+    for (size_t i = 0; i < sensors.size(); i++) {
+        const SensorReading& sensor = sensors[i];
+        if (sensor.kind != SENSOR_FAN || !sensor.valid) continue;
+        if (best < 0 || sensor.value > sensors[best].value) best = (int)i;
+    }
+    return best;
+}
+
+static ThermalInfo thermalFromReading(const SensorReading* sensor) {
+    ThermalInfo thermal_info = {};
+    if (!sensor || !sensor->valid) return thermal_info;
+    thermal_info.available = true;
+    thermal_info.temperature = sensor->value;
+    thermal_info.critical = sensor->critical;
+    thermal_info.source = sensor->chip + " " + sensor->label;
+    return thermal_info;
+}
+
+static FanInfo fanFromReading(const SensorReading* sensor) {
+    FanInfo fan_info = {};
+    fan_info.level = -1;
+    if (!sensor || !sensor->valid) return fan_info;
+    fan_info.available = true;
+    fan_info.speed = (int)sensor->value;
+    fan_info.active = fan_info.speed > 0;
+    fan_info.level = sensor->duty_percent;
+    fan_info.source = sensor->chip + " " + sensor->label;
+    return fan_info;
+}
+
+bool readSensors(std::vector<SensorReading>& sensors) {
+    std::lock_guard<std::mutex> lock(sensor_mutex);
+    if (!sensors_scanned) {
+        openUeventSocket();
+        scanSensors();
+    } else if (sensorsHotplugged()) {
+        scanSensors();
+    }
+
+    sensors.clear();
+    for (TrackedSensor& sensor : tracked_sensors) {
+        refreshSensor(sensor);
+        sensors.push_back(sensor.reading);
+    }
+    // Indexes match tracked_sensors
+    headline_thermal = thermalSensorIndex(sensors);
+    headline_fan = fanSensorIndex(sensors);
+    return !sensors.empty();
+}
+
+// Reads only the two sensors the last full sweep picked, for graphs sampled
+// faster than every sensor should be (on nvme and drivetemp each read is a
+// command to the drive). Nothing is available before the first readSensors().
+void readHeadlineSensors(ThermalInfo& thermal, FanInfo& fan) {
+    std::lock_guard<std::mutex> lock(sensor_mutex);
+    TrackedSensor* thermal_sensor = headline_thermal >= 0 ? &tracked_sensors[headline_thermal] : nullptr;
+    TrackedSensor* fan_sensor = headline_fan >= 0 ? &tracked_sensors[headline_fan] : nullptr;
+    if (thermal_sensor) refreshSensor(*thermal_sensor);
+    if (fan_sensor) refreshSensor(*fan_sensor);
+    thermal = thermalFromReading(thermal_sensor ? &thermal_sensor->reading : nullptr);
+    fan = fanFromReading(fan_sensor ? &fan_sensor->reading : nullptr);
+}
+
+const char* sensorKindName(SensorKind kind) {
+    switch (kind) {
+        case SENSOR_TEMPERATURE: return "temperature";
+        case SENSOR_FAN: return "fan";
+        case SENSOR_VOLTAGE: return "voltage";
+        case SENSOR_POWER: return "power";
+        default: return "current";
+    }
+}
+
+const char* sensorUnit(SensorKind kind) {
+    switch (kind) {
+        case SENSOR_TEMPERATURE: return "°C";
+        case SENSOR_FAN: return "RPM";
+        case SENSOR_VOLTAGE: return "V";
+        case SENSOR_POWER: return "W";
+        default: return "A";
+    }
+}
+
+ThermalInfo thermalFromSensors(const std::vector<SensorReading>& sensors) {
+    int index = thermalSensorIndex(sensors);
+    return thermalFromReading(index >= 0 ? &sensors[index] : nullptr);
+}
+
+FanInfo fanFromSensors(const std::vector<SensorReading>& sensors) {
+    int index = fanSensorIndex(sensors);
+    return fanFromReading(index >= 0 ? &sensors[index] : nullptr);
+}
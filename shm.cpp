@@ -0,0 +1,118 @@
+#include "header.h"
+#include "shm_snapshot.h"
+#include <cstring>
+
+// Writer state
+static SharedSnapshot* shared_snapshot = nullptr;
+static std::string shared_snapshot_name;
+
+static void copyString(char* dest, size_t size, const std::string& src) {
+    size_t length = std::min(size - 1, src.size());
+    memcpy(dest, src.data(), length);
+    dest[length] = '\0';
+}
+
+// Called from the sampler thread
+static void publishSharedSnapshot(const MetricsSnapshot& snapshot) {
+    static SharedSnapshotData data;
+    memset(&data, 0, sizeof(data));
+
+    data.timestamp_ms = snapshot.timestamp_ms;
+    copyString(data.hostname, sizeof(data.hostname), snapshot.system.hostname);
+    copyString(data.os_type, sizeof(data.os_type), snapshot.system.os_type);
+
+    data.total_processes = snapshot.system.total_processes;
+    data.running_processes = snapshot.system.running_processes;
+    data.sleeping_processes = snapshot.system.sleeping_processes;
+    data.zombie_processes = snapshot.system.zombie_processes;
+    data.stopped_processes = snapshot.system.stopped_processes;
+
+    data.cpu_usage = snapshot.cpu.usage_percent;
+    data.cpu_user = snapshot.cpu.user;
+    data.cpu_nice = snapshot.cpu.nice;
+    data.cpu_system = snapshot.cpu.system;
+    data.cpu_idle = snapshot.cpu.idle;
+    data.cpu_iowait = snapshot.cpu.iowait;
+    data.cpu_irq = snapshot.cpu.irq;
+    data.cpu_softirq = snapshot.cpu.softirq;
+
+    data.total_ram = snapshot.memory.total_ram;
+    data.used_ram = snapshot.memory.used_ram;
+    data.free_ram = snapshot.memory.free_ram;
+    data.total_swap = snapshot.memory.total_swap;
+    data.used_swap = snapshot.memory.used_swap;
+    data.free_swap = snapshot.memory.free_swap;
+    data.total_disk = snapshot.memory.total_disk;
+    data.used_disk = snapshot.memory.used_disk;
+    data.free_disk = snapshot.memory.free_disk;
+
+    data.temperature_available = snapshot.thermal.available ? 1 : 0;
+    data.temperature = snapshot.thermal.temperature;
+    data.fan_available = snapshot.fan.available ? 1 : 0;
+    data.fan_active = snapshot.fan.active ? 1 : 0;
+    data.fan_speed = snapshot.fan.speed;
+
+    data.interface_count = std::min<size_t>(snapshot.interfaces.size(), SHARED_SNAPSHOT_MAX_INTERFACES);
+    for (uint32_t i = 0; i < data.interface_count; i++) {
+        const NetworkInterface& iface = snapshot.interfaces[i];
+        SharedInterface& out = data.interfaces[i];
+        copyString(out.name, sizeof(out.name), iface.name);
+        out.rx_bytes = iface.rx_bytes;
+        out.rx_packets = iface.rx_packets;
+        out.rx_errs = iface.rx_errs;
+        out.rx_drop = iface.rx_drop;
+        out.tx_bytes = iface.tx_bytes;
+        out.tx_packets = iface.tx_packets;
+        out.tx_errs = iface.tx_errs;
+        out.tx_drop = iface.tx_drop;
+    }
+
+    data.process_count = std::min<size_t>(snapshot.top_processes.size(), SHARED_SNAPSHOT_MAX_PROCESSES);
+    for (uint32_t i = 0; i < data.process_count; i++) {
+        const ProcessInfo& proc = snapshot.top_processes[i];
+        SharedProcess& out = data.processes[i];
+        out.pid = proc.pid;
+        copyString(out.name, sizeof(out.name), proc.name);
+        copyString(out.state, sizeof(out.state), proc.state);
+        out.cpu_usage = proc.cpu_usage;
+        out.memory_usage = proc.memory_usage;
+        out.memory_kb = proc.memory_kb;
+    }
+
+    writeSharedSnapshot(shared_snapshot, data);
+}
+
+bool startSharedSnapshot(const std::string& name) {
+    if (shared_snapshot || name.empty()) return false;
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, sizeof(SharedSnapshot)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(SharedSnapshot), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    // Readers treat sequence 0 as "nothing published yet"
+    shared_snapshot = (SharedSnapshot*)mapping;
+    shared_snapshot->sequence.store(0, std::memory_order_relaxed);
+    shared_snapshot->data_size = sizeof(SharedSnapshotData);
+    shared_snapshot->version = SHARED_SNAPSHOT_VERSION;
+    shared_snapshot->magic = SHARED_SNAPSHOT_MAGIC;
+    shared_snapshot_name = name;
+
+    addSnapshotListener(publishSharedSnapshot);
+    return true;
+}
+
+void stopSharedSnapshot() {
+    if (!shared_snapshot) return;
+
+    munmap(shared_snapshot, sizeof(SharedSnapshot));
+    shm_unlink(shared_snapshot_name.c_str());
+    shared_snapshot = nullptr;
+}
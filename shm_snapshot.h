@@ -0,0 +1,136 @@
+#ifndef SHM_SNAPSHOT_H
+#define SHM_SNAPSHOT_H
+
+// Shared-memory snapshot published by the monitor (--shm NAME).
+//
+// This header is the whole reader library: it has no dependency on ImGui or SDL,
+// so local tools can include it, call openSharedSnapshot() once and then read
+// consistent snapshots with readSharedSnapshot() without locks or syscalls.
+//
+// The region is guarded by a sequence lock. The writer makes the sequence odd,
+// updates the data and makes it even again; a reader retries whenever it saw an
+// odd sequence or the sequence changed while it was copying.
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHARED_SNAPSHOT_MAGIC 0x534d4f4eu // "SMON"
+#define SHARED_SNAPSHOT_VERSION 2
+#define SHARED_SNAPSHOT_DEFAULT_NAME "/system-monitor"
+#define SHARED_SNAPSHOT_MAX_INTERFACES 64
+#define SHARED_SNAPSHOT_MAX_PROCESSES 32
+
+struct SharedInterface {
+    char name[32];
+    uint64_t rx_bytes, rx_packets, rx_errs, rx_drop;
+    uint64_t tx_bytes, tx_packets, tx_errs, tx_drop;
+};
+
+struct SharedProcess {
+    int32_t pid;
+    char name[32];
+    char state[4];
+    float cpu_usage;
+    float memory_usage;
+    uint64_t memory_kb;
+};
+
+struct SharedSnapshotData {
+    int64_t timestamp_ms;
+    char hostname[64];
+    char os_type[128];
+
+    // Process counts
+    int32_t total_processes, running_processes, sleeping_processes, zombie_processes, stopped_processes;
+
+    // CPU usage and cumulative jiffies
+    float cpu_usage;
+    uint64_t cpu_user, cpu_nice, cpu_system, cpu_idle, cpu_iowait, cpu_irq, cpu_softirq;
+
+    // Memory, swap and root filesystem in kB
+    uint64_t total_ram, used_ram, free_ram;
+    uint64_t total_swap, used_swap, free_swap;
+    uint64_t total_disk, used_disk, free_disk;
+
+    // Sensor values are meaningless unless the matching *_available is 1
+    int32_t temperature_available;
+    float temperature;
+    int32_t fan_available;
+    int32_t fan_active;
+    int32_t fan_speed;
+
+    uint32_t interface_count;
+    SharedInterface interfaces[SHARED_SNAPSHOT_MAX_INTERFACES];
+    uint32_t process_count;
+    SharedProcess processes[SHARED_SNAPSHOT_MAX_PROCESSES];
+};
+
+struct SharedSnapshot {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t data_size;
+    std::atomic<uint32_t> sequence;
+    SharedSnapshotData data;
+};
+
+// Map an existing region read-only. Returns nullptr if it is missing or incompatible.
+inline const SharedSnapshot* openSharedSnapshot(const char* name = SHARED_SNAPSHOT_DEFAULT_NAME) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return nullptr;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SharedSnapshot)) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* mapping = mmap(nullptr, sizeof(SharedSnapshot), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return nullptr;
+
+    const SharedSnapshot* snapshot = (const SharedSnapshot*)mapping;
+    if (snapshot->magic != SHARED_SNAPSHOT_MAGIC || snapshot->version != SHARED_SNAPSHOT_VERSION ||
+        snapshot->data_size != sizeof(SharedSnapshotData)) {
+        munmap(mapping, sizeof(SharedSnapshot));
+        return nullptr;
+    }
+    return snapshot;
+}
+
+inline void closeSharedSnapshot(const SharedSnapshot* snapshot) {
+    if (snapshot) munmap((void*)snapshot, sizeof(SharedSnapshot));
+}
+
+// Copy a consistent snapshot. Returns false if nothing has been published yet
+// or the writer kept updating for max_attempts rounds.
+inline bool readSharedSnapshot(const SharedSnapshot* snapshot, SharedSnapshotData& out, int max_attempts = 1000) {
+    for (int attempt = 0; attempt < max_attempts; attempt++) {
+        uint32_t before = snapshot->sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        if (before == 0) return false;
+
+        memcpy(&out, (const void*)&snapshot->data, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (snapshot->sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+// Writer side, used by the monitor itself
+inline void writeSharedSnapshot(SharedSnapshot* snapshot, const SharedSnapshotData& data) {
+    uint32_t sequence = snapshot->sequence.load(std::memory_order_relaxed);
+    snapshot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy((void*)&snapshot->data, &data, sizeof(data));
+
+    snapshot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+#endif // SHM_SNAPSHOT_H
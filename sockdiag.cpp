@@ -0,0 +1,298 @@
+#include "header.h"
+#include <cstring>
+#include <fcntl.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include <linux/unix_diag.h>
+#include <linux/tcp.h>
+
+// Socket inventory from NETLINK_SOCK_DIAG: one dump each for TCP and UDP over
+// IPv4 and IPv6, and one for Unix sockets. Owners come from an inode -> pid map
+// that only walks /proc/PID/fd when a dump contains inodes it has not seen, and
+// stops as soon as they are all found.
+#define SOCK_DIAG_BUFFER_BYTES (256 * 1024)
+
+static std::vector<char> sock_diag_buffer;
+
+static std::unordered_map<unsigned long long, int> socket_owners; // inode -> pid
+static std::unordered_set<unsigned long long> socket_unowned; // not found in any fd table we can read
+static std::unordered_map<int, std::string> owner_names; // pid -> comm
+
+// Kernel socket state numbers (include/net/tcp_states.h); glibc's copy in
+// <netinet/tcp.h> cannot be included next to <linux/tcp.h>
+enum { SOCKET_ESTABLISHED = 1, SOCKET_LISTEN = 10 };
+
+static const char* tcp_state_names[] = {
+    "UNKNOWN", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2", "TIME_WAIT",
+    "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING", "NEW_SYN_RECV",
+};
+
+const char* socketStateName(const SocketInfo& socket) {
+    if (socket.protocol == IPPROTO_UDP) return socket.state == SOCKET_ESTABLISHED ? "ESTAB" : "UNCONN";
+    if (socket.family == AF_UNIX) {
+        if (socket.state == SOCKET_LISTEN) return "LISTEN";
+        return socket.state == SOCKET_ESTABLISHED ? "ESTAB" : "UNCONN";
+    }
+    return socket.state < sizeof(tcp_state_names) / sizeof(tcp_state_names[0]) ? tcp_state_names[socket.state] : "UNKNOWN";
+}
+
+const char* socketProtocolName(const SocketInfo& socket) {
+    if (socket.family == AF_UNIX) return socket.unix_type == SOCK_STREAM ? "unix/stream" : socket.unix_type == SOCK_DGRAM ? "unix/dgram" : "unix/seqpacket";
+    bool v6 = socket.family == AF_INET6;
+    if (socket.protocol == IPPROTO_TCP) return v6 ? "tcp6" : "tcp";
+    return v6 ? "udp6" : "udp";
+}
+
+std::string formatSocketAddress(const SocketInfo& socket, bool remote) {
+    if (socket.family == AF_UNIX) return remote ? "" : socket.unix_path;
+
+    char text[INET6_ADDRSTRLEN];
+    const unsigned char* address = remote ? socket.remote_address : socket.local_address;
+    inet_ntop(socket.family, address, text, sizeof(text));
+    unsigned short port = remote ? socket.remote_port : socket.local_port;
+    std::string port_text = port ? std::to_string(port) : "*";
+    return socket.family == AF_INET6 ? "[" + std::string(text) + "]:" + port_text : std::string(text) + ":" + port_text;
+}
+
+// Sends one SOCK_DIAG_BY_FAMILY dump request and calls handle() for each reply
+template <typename Handler>
+static bool sockDiagDump(int fd, const void* request, size_t request_length, Handler handle) {
+    struct {
+        nlmsghdr header;
+        char body[sizeof(inet_diag_req_v2)];
+    } message = {};
+    message.header.nlmsg_len = NLMSG_LENGTH(request_length);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    memcpy(message.body, request, request_length);
+    if (send(fd, &message, message.header.nlmsg_len, 0) < 0) return false;
+
+    while (true) {
+        ssize_t length = recv(fd, sock_diag_buffer.data(), sock_diag_buffer.size(), 0);
+        if (length < 0 && errno == EINTR) continue;
+        if (length <= 0) return false;
+        for (nlmsghdr* msg = (nlmsghdr*)sock_diag_buffer.data(); NLMSG_OK(msg, (size_t)length); msg = NLMSG_NEXT(msg, length)) {
+            if (msg->nlmsg_type == NLMSG_DONE) return true;
+            if (msg->nlmsg_type == NLMSG_ERROR) return false;
+            handle(msg);
+        }
+    }
+}
+
+static bool dumpInetSockets(int fd, int family, int protocol, std::vector<SocketInfo>& sockets) {
+    inet_diag_req_v2 request = {};
+    request.sdiag_family = family;
+    request.sdiag_protocol = protocol;
+    request.idiag_states = ~0U;
+    if (protocol == IPPROTO_TCP) request.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+
+    return sockDiagDump(fd, &request, sizeof(request), [&](const nlmsghdr* msg) {
+        const inet_diag_msg* diag = (const inet_diag_msg*)NLMSG_DATA(msg);
+        sockets.emplace_back();
+        SocketInfo& socket = sockets.back();
+        socket.family = diag->idiag_family;
+        socket.protocol = protocol;
+        socket.state = diag->idiag_state;
+        socket.local_port = ntohs(diag->id.idiag_sport);
+        socket.remote_port = ntohs(diag->id.idiag_dport);
+        size_t address_length = family == AF_INET ? 4 : 16;
+        memcpy(socket.local_address, diag->id.idiag_src, address_length);
+        memcpy(socket.remote_address, diag->id.idiag_dst, address_length);
+        socket.rx_queue = diag->idiag_rqueue;
+        socket.tx_queue = diag->idiag_wqueue;
+        socket.uid = diag->idiag_uid;
+        socket.inode = diag->idiag_inode;
+        socket.cookie = (unsigned long long)diag->id.idiag_cookie[1] << 32 | diag->id.idiag_cookie[0];
+
+        int attr_length = (int)msg->nlmsg_len - NLMSG_LENGTH(sizeof(*diag));
+        for (const rtattr* attr = (const rtattr*)(diag + 1); RTA_OK(attr, attr_length); attr = RTA_NEXT(attr, attr_length)) {
+            if (attr->rta_type != INET_DIAG_INFO) continue;
+            // Older kernels send a shorter tcp_info; missing fields stay zero
+            tcp_info info = {};
+            memcpy(&info, RTA_DATA(attr), std::min<size_t>(RTA_PAYLOAD(attr), sizeof(info)));
+            socket.has_tcp_info = true;
+            socket.rtt_ms = info.tcpi_rtt / 1000.0f;
+            socket.rtt_var_ms = info.tcpi_rttvar / 1000.0f;
+            socket.cwnd = info.tcpi_snd_cwnd;
+            socket.retransmits = info.tcpi_total_retrans;
+            socket.bytes_acked = info.tcpi_bytes_acked;
+            socket.bytes_received = info.tcpi_bytes_received;
+        }
+    });
+}
+
+static bool dumpUnixSockets(int fd, std::vector<SocketInfo>& sockets) {
+    unix_diag_req request = {};
+    request.sdiag_family = AF_UNIX;
+    request.udiag_states = ~0U;
+    request.udiag_show = UDIAG_SHOW_NAME | UDIAG_SHOW_RQLEN;
+
+    return sockDiagDump(fd, &request, sizeof(request), [&](const nlmsghdr* msg) {
+        const unix_diag_msg* diag = (const unix_diag_msg*)NLMSG_DATA(msg);
+        sockets.emplace_back();
+        SocketInfo& socket = sockets.back();
+        socket.family = AF_UNIX;
+        socket.unix_type = diag->udiag_type;
+        socket.state = diag->udiag_state;
+        socket.inode = diag->udiag_ino;
+        socket.cookie = (unsigned long long)diag->udiag_cookie[1] << 32 | diag->udiag_cookie[0];
+
+        int attr_length = (int)msg->nlmsg_len - NLMSG_LENGTH(sizeof(*diag));
+        for (const rtattr* attr = (const rtattr*)(diag + 1); RTA_OK(attr, attr_length); attr = RTA_NEXT(attr, attr_length)) {
+            if (attr->rta_type == UNIX_DIAG_NAME && RTA_PAYLOAD(attr) > 0) {
+                // Abstract names start with a NUL; show them with a leading '@'
+                const char* name = (const char*)RTA_DATA(attr);
+                socket.unix_path = name[0] ? std::string(name, strnlen(name, RTA_PAYLOAD(attr)))
+                                           : "@" + std::string(name + 1, RTA_PAYLOAD(attr) - 1);
+            } else if (attr->rta_type == UNIX_DIAG_RQLEN && RTA_PAYLOAD(attr) >= sizeof(unix_diag_rqlen)) {
+                const unix_diag_rqlen* queues = (const unix_diag_rqlen*)RTA_DATA(attr);
+                socket.rx_queue = queues->udiag_rqueue;
+                socket.tx_queue = queues->udiag_wqueue;
+            }
+        }
+    });
+}
+
+bool dumpSockets(std::vector<SocketInfo>& sockets) {
+    sockets.clear();
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0) return false;
+    sock_diag_buffer.resize(SOCK_DIAG_BUFFER_BYTES);
+
+    // A kernel without UDP or IPv6 diag support still reports the rest
+    bool any = false;
+    const int families[] = {AF_INET, AF_INET6};
+    const int protocols[] = {IPPROTO_TCP, IPPROTO_UDP};
+    for (int family : families) {
+        for (int protocol : protocols) {
+            any |= dumpInetSockets(fd, family, protocol, sockets);
+        }
+    }
+    any |= dumpUnixSockets(fd, sockets);
+    close(fd);
+    return any;
+}
+
+// Records every socket in pid's fd table; returns how many of the wanted inodes it found
+static size_t scanProcessFds(int pid, std::unordered_set<unsigned long long>& wanted) {
+    char path[32];
+    snprintf(path, sizeof(path), "/proc/%d/fd", pid);
+    int dir_fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd < 0) return 0;
+    DIR* dir = fdopendir(dir_fd);
+    if (!dir) {
+        close(dir_fd);
+        return 0;
+    }
+
+    size_t found = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] == '.') continue;
+        char target[64];
+        ssize_t length = readlinkat(dir_fd, entry->d_name, target, sizeof(target) - 1);
+        if (length <= 8 || strncmp(target, "socket:[", 8) != 0) continue;
+        target[length] = '\0';
+
+        unsigned long long inode = strtoull(target + 8, nullptr, 10);
+        socket_owners[inode] = pid;
+        found += wanted.erase(inode);
+    }
+    closedir(dir);
+    return found;
+}
+
+static const std::string& ownerName(int pid) {
+    auto it = owner_names.find(pid);
+    if (it != owner_names.end()) return it->second;
+
+    std::ifstream comm_file("/proc/" + std::to_string(pid) + "/comm");
+    std::string name;
+    std::getline(comm_file, name);
+    return owner_names[pid] = name;
+}
+
+void resolveSocketOwners(std::vector<SocketInfo>& sockets) {
+    // TIME_WAIT and other orphaned sockets have inode 0 and no owner
+    std::unordered_set<unsigned long long> live;
+    std::unordered_set<unsigned long long> wanted;
+    live.reserve(sockets.size());
+    for (const SocketInfo& socket : sockets) {
+        if (socket.inode == 0) continue;
+        live.insert(socket.inode);
+        if (!socket_owners.count(socket.inode) && !socket_unowned.count(socket.inode)) wanted.insert(socket.inode);
+    }
+
+    if (!wanted.empty()) {
+        // Processes that already own sockets are the likeliest to have opened new ones
+        std::unordered_set<int> scanned;
+        std::vector<int> owners;
+        for (const auto& entry : socket_owners) owners.push_back(entry.second);
+        std::sort(owners.begin(), owners.end());
+        owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+        for (int pid : owners) {
+            if (wanted.empty()) break;
+            scanProcessFds(pid, wanted);
+            scanned.insert(pid);
+        }
+
+        DIR* proc_dir = wanted.empty() ? nullptr : opendir("/proc");
+        if (proc_dir) {
+            struct dirent* entry;
+            while (!wanted.empty() && (entry = readdir(proc_dir)) != nullptr) {
+                int pid = atoi(entry->d_name);
+                if (pid <= 0 || scanned.count(pid)) continue;
+                scanProcessFds(pid, wanted);
+            }
+            closedir(proc_dir);
+        }
+
+        // Owned by processes we may not inspect; do not search for them again
+        socket_unowned.insert(wanted.begin(), wanted.end());
+    }
+
+    // Forget closed sockets and processes that no longer own any
+    for (auto it = socket_owners.begin(); it != socket_owners.end(); ) {
+        it = live.count(it->first) ? std::next(it) : socket_owners.erase(it);
+    }
+    for (auto it = socket_unowned.begin(); it != socket_unowned.end(); ) {
+        it = live.count(*it) ? std::next(it) : socket_unowned.erase(it);
+    }
+    std::unordered_set<int> owner_pids;
+    for (const auto& entry : socket_owners) owner_pids.insert(entry.second);
+    for (auto it = owner_names.begin(); it != owner_names.end(); ) {
+        it = owner_pids.count(it->first) ? std::next(it) : owner_names.erase(it);
+    }
+
+    for (SocketInfo& socket : sockets) {
+        auto owner = socket.inode ? socket_owners.find(socket.inode) : socket_owners.end();
+        if (owner == socket_owners.end()) continue;
+        socket.pid = owner->second;
+        socket.process = ownerName(owner->second);
+    }
+}
+
+SocketSummary summarizeSockets(const std::vector<SocketInfo>& sockets) {
+    SocketSummary summary;
+    for (const SocketInfo& socket : sockets) {
+        if (socket.family == AF_UNIX) {
+            summary.unix_sockets++;
+        } else if (socket.protocol == IPPROTO_UDP) {
+            summary.udp_sockets++;
+        } else if (socket.state < SOCKET_TCP_STATES) {
+            summary.tcp_states[socket.state]++;
+        }
+        if (socket.inode != 0 && socket.pid < 0) summary.unowned++;
+    }
+    return summary;
+}
+
+const char* tcpStateName(int state) {
+    return state >= 0 && state < SOCKET_TCP_STATES ? tcp_state_names[state] : "UNKNOWN";
+}
@@ -0,0 +1,993 @@
+#include "header.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <netdb.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Wire format
+//
+// Every frame is   u32 length (little endian, excludes itself) | u8 type | u64 timestamp_ms | records...
+//
+// A HELLO frame carries a single u8 protocol version. A DELTA frame carries a list of
+// records that patch the receiver's field table:
+//   DEFINE  varint id, varint len, name      bind id to a field name
+//   NUMBER  varint id, f64                   set a numeric field
+//   STRING  varint id, varint len, bytes     set a text field
+//   REMOVE  varint id                        drop a field, the id may be redefined later
+// The agent only emits records for fields whose value changed since the previous frame.
+// A viewer that connects mid-stream first receives a keyframe built from the full table.
+
+static const uint8_t STREAM_VERSION = 1;
+static const uint8_t FRAME_HELLO = 1;
+static const uint8_t FRAME_DELTA = 2;
+static const uint8_t RECORD_DEFINE = 1;
+static const uint8_t RECORD_NUMBER = 2;
+static const uint8_t RECORD_STRING = 3;
+static const uint8_t RECORD_REMOVE = 4;
+static const size_t MAX_FRAME_SIZE = 16 * 1024 * 1024;
+static const size_t MAX_CLIENT_BACKLOG = 8 * 1024 * 1024;
+
+struct FieldValue {
+    bool is_string = false;
+    double number = 0.0;
+    std::string text;
+
+    bool operator==(const FieldValue& other) const {
+        return is_string == other.is_string && number == other.number && text == other.text;
+    }
+};
+
+typedef std::vector<std::pair<std::string, FieldValue>> FieldList;
+
+static FieldValue numberField(double value) {
+    FieldValue field;
+    field.number = value;
+    return field;
+}
+
+static FieldValue stringField(const std::string& value) {
+    FieldValue field;
+    field.is_string = true;
+    field.text = value;
+    return field;
+}
+
+// Field tables shared by the flattening and rebuilding code
+static const struct { const char* key; long CPUInfo::* field; } cpu_fields[] = {
+    {"cpu/user", &CPUInfo::user}, {"cpu/nice", &CPUInfo::nice}, {"cpu/system", &CPUInfo::system},
+    {"cpu/idle", &CPUInfo::idle}, {"cpu/iowait", &CPUInfo::iowait}, {"cpu/irq", &CPUInfo::irq},
+    {"cpu/softirq", &CPUInfo::softirq},
+};
+
+static const struct { const char* key; unsigned long MemoryInfo::* field; } memory_fields[] = {
+    {"mem/total_ram", &MemoryInfo::total_ram}, {"mem/used_ram", &MemoryInfo::used_ram},
+    {"mem/free_ram", &MemoryInfo::free_ram}, {"mem/total_swap", &MemoryInfo::total_swap},
+    {"mem/used_swap", &MemoryInfo::used_swap}, {"mem/free_swap", &MemoryInfo::free_swap},
+    {"mem/total_disk", &MemoryInfo::total_disk}, {"mem/used_disk", &MemoryInfo::used_disk},
+    {"mem/free_disk", &MemoryInfo::free_disk}, {"mem/available_ram", &MemoryInfo::available_ram},
+    {"mem/buffers", &MemoryInfo::buffers}, {"mem/cached", &MemoryInfo::cached},
+    {"mem/shmem", &MemoryInfo::shmem}, {"mem/slab", &MemoryInfo::slab},
+    {"mem/slab_reclaimable", &MemoryInfo::slab_reclaimable}, {"mem/anon_pages", &MemoryInfo::anon_pages},
+    {"mem/mapped", &MemoryInfo::mapped}, {"mem/dirty", &MemoryInfo::dirty},
+    {"mem/writeback", &MemoryInfo::writeback}, {"mem/commit_limit", &MemoryInfo::commit_limit},
+    {"mem/committed_as", &MemoryInfo::committed_as}, {"mem/hugepages_total", &MemoryInfo::hugepages_total},
+    {"mem/hugepages_free", &MemoryInfo::hugepages_free}, {"mem/hugepages_reserved", &MemoryInfo::hugepages_reserved},
+    {"mem/hugepages_surplus", &MemoryInfo::hugepages_surplus}, {"mem/hugepage_size", &MemoryInfo::hugepage_size},
+};
+
+static const struct { const char* key; unsigned long VmStatInfo::* field; } vmstat_fields[] = {
+    {"vm/pgfault", &VmStatInfo::pgfault}, {"vm/pgmajfault", &VmStatInfo::pgmajfault},
+    {"vm/pswpin", &VmStatInfo::pswpin}, {"vm/pswpout", &VmStatInfo::pswpout},
+    {"vm/pgscan_kswapd", &VmStatInfo::pgscan_kswapd}, {"vm/pgscan_direct", &VmStatInfo::pgscan_direct},
+    {"vm/pgsteal_kswapd", &VmStatInfo::pgsteal_kswapd}, {"vm/pgsteal_direct", &VmStatInfo::pgsteal_direct},
+    {"vm/allocstall", &VmStatInfo::allocstall}, {"vm/compact_stall", &VmStatInfo::compact_stall},
+    {"vm/thp_fault_alloc", &VmStatInfo::thp_fault_alloc}, {"vm/thp_fault_fallback", &VmStatInfo::thp_fault_fallback},
+    {"vm/thp_collapse_alloc", &VmStatInfo::thp_collapse_alloc}, {"vm/thp_split_page", &VmStatInfo::thp_split_page},
+    {"vm/oom_kill", &VmStatInfo::oom_kill},
+};
+
+static const struct { const char* key; int SystemInfo::* field; } process_count_fields[] = {
+    {"sys/total", &SystemInfo::total_processes}, {"sys/running", &SystemInfo::running_processes},
+    {"sys/sleeping", &SystemInfo::sleeping_processes}, {"sys/zombie", &SystemInfo::zombie_processes},
+    {"sys/stopped", &SystemInfo::stopped_processes},
+};
+
+static const struct { const char* key; std::string SystemInfo::* field; } system_text_fields[] = {
+    {"sys/os", &SystemInfo::os_type}, {"sys/user", &SystemInfo::username},
+    {"sys/hostname", &SystemInfo::hostname}, {"sys/cpu_type", &SystemInfo::cpu_type},
+};
+
+static const struct { const char* key; unsigned long NetworkInterface::* field; } interface_fields[] = {
+    {"rx_bytes", &NetworkInterface::rx_bytes}, {"rx_packets", &NetworkInterface::rx_packets},
+    {"rx_errs", &NetworkInterface::rx_errs}, {"rx_drop", &NetworkInterface::rx_drop},
+    {"rx_fifo", &NetworkInterface::rx_fifo}, {"rx_frame", &NetworkInterface::rx_frame},
+    {"rx_compressed", &NetworkInterface::rx_compressed}, {"rx_multicast", &NetworkInterface::rx_multicast},
+    {"tx_bytes", &NetworkInterface::tx_bytes}, {"tx_packets", &NetworkInterface::tx_packets},
+    {"tx_errs", &NetworkInterface::tx_errs}, {"tx_drop", &NetworkInterface::tx_drop},
+    {"tx_fifo", &NetworkInterface::tx_fifo}, {"tx_colls", &NetworkInterface::tx_colls},
+    {"tx_carrier", &NetworkInterface::tx_carrier}, {"tx_compressed", &NetworkInterface::tx_compressed},
+};
+
+// Turn a snapshot into named fields. Processes are keyed by rank so the table stays small.
+static FieldList flattenSnapshot(const MetricsSnapshot& snapshot) {
+    FieldList fields;
+
+    for (const auto& f : system_text_fields) fields.push_back({f.key, stringField(snapshot.system.*f.field)});
+    for (const auto& f : process_count_fields) fields.push_back({f.key, numberField(snapshot.system.*f.field)});
+
+    fields.push_back({"cpu/usage", numberField(snapshot.cpu.usage_percent)});
+    for (const auto& f : cpu_fields) fields.push_back({f.key, numberField(snapshot.cpu.*f.field)});
+    for (const auto& f : memory_fields) fields.push_back({f.key, numberField(snapshot.memory.*f.field)});
+    for (const auto& f : vmstat_fields) fields.push_back({f.key, numberField(snapshot.vmstat.*f.field)});
+
+    fields.push_back({"thermal/available", numberField(snapshot.thermal.available ? 1 : 0)});
+    fields.push_back({"thermal/temperature", numberField(snapshot.thermal.temperature)});
+    fields.push_back({"thermal/critical", numberField(snapshot.thermal.critical)});
+    fields.push_back({"thermal/source", stringField(snapshot.thermal.source)});
+    fields.push_back({"fan/available", numberField(snapshot.fan.available ? 1 : 0)});
+    fields.push_back({"fan/active", numberField(snapshot.fan.active ? 1 : 0)});
+    fields.push_back({"fan/speed", numberField(snapshot.fan.speed)});
+    fields.push_back({"fan/level", numberField(snapshot.fan.level)});
+    fields.push_back({"fan/source", stringField(snapshot.fan.source)});
+
+    // Interface names cannot contain '/', so it is a safe separator
+    for (const auto& iface : snapshot.interfaces) {
+        std::string prefix = "net/" + iface.name + "/";
+        fields.push_back({prefix + "ipv4", stringField(iface.ipv4_address)});
+        if (!iface.ipv6_address.empty()) fields.push_back({prefix + "ipv6", stringField(iface.ipv6_address)});
+        fields.push_back({prefix + "group", stringField(iface.group)});
+        fields.push_back({prefix + "speed", numberField(iface.link_speed_mbps)});
+        fields.push_back({prefix + "ifindex", numberField(iface.ifindex)});
+        for (const auto& f : interface_fields) fields.push_back({prefix + f.key, numberField(iface.*f.field)});
+    }
+
+    for (size_t i = 0; i < snapshot.top_processes.size(); i++) {
+        const ProcessInfo& proc = snapshot.top_processes[i];
+        std::string prefix = "proc/" + std::to_string(i) + "/";
+        fields.push_back({prefix + "pid", numberField(proc.pid)});
+        fields.push_back({prefix + "name", stringField(proc.name)});
+        fields.push_back({prefix + "state", stringField(proc.state)});
+        fields.push_back({prefix + "cpu", numberField(proc.cpu_usage)});
+        fields.push_back({prefix + "mem", numberField(proc.memory_usage)});
+        fields.push_back({prefix + "rss", numberField(proc.memory_kb)});
+        if (proc.io_known) {
+            fields.push_back({prefix + "io_read", numberField(proc.io_read_rate)});
+            fields.push_back({prefix + "io_write", numberField(proc.io_write_rate)});
+            fields.push_back({prefix + "io_calls", numberField(proc.io_syscall_rate)});
+        }
+    }
+
+    fields.push_back({"time", numberField(snapshot.timestamp_ms)});
+    return fields;
+}
+
+// Rebuild a snapshot from the viewer's field table
+static MetricsSnapshot rebuildSnapshot(const std::map<std::string, FieldValue>& fields) {
+    MetricsSnapshot snapshot;
+
+    auto number = [&](const std::string& key) {
+        auto it = fields.find(key);
+        return it != fields.end() ? it->second.number : 0.0;
+    };
+    auto text = [&](const std::string& key) {
+        auto it = fields.find(key);
+        return it != fields.end() ? it->second.text : std::string();
+    };
+
+    for (const auto& f : system_text_fields) snapshot.system.*f.field = text(f.key);
+    for (const auto& f : process_count_fields) snapshot.system.*f.field = (int)number(f.key);
+
+    snapshot.cpu.usage_percent = (float)number("cpu/usage");
+    for (const auto& f : cpu_fields) snapshot.cpu.*f.field = (long)number(f.key);
+    for (const auto& f : memory_fields) snapshot.memory.*f.field = (unsigned long)number(f.key);
+    for (const auto& f : vmstat_fields) snapshot.vmstat.*f.field = (unsigned long)number(f.key);
+
+    snapshot.thermal.available = number("thermal/available") != 0.0;
+    snapshot.thermal.temperature = (float)number("thermal/temperature");
+    snapshot.thermal.critical = (float)number("thermal/critical");
+    snapshot.thermal.source = text("thermal/source");
+    snapshot.fan.available = number("fan/available") != 0.0;
+    snapshot.fan.active = number("fan/active") != 0.0;
+    snapshot.fan.speed = (int)number("fan/speed");
+    snapshot.fan.level = (int)number("fan/level");
+    snapshot.fan.source = text("fan/source");
+    snapshot.timestamp_ms = (long long)number("time");
+
+    // Keys are sorted, so each interface's fields are contiguous
+    for (auto it = fields.lower_bound("net/"); it != fields.end() && it->first.compare(0, 4, "net/") == 0; ++it) {
+        size_t slash = it->first.rfind('/');
+        std::string name = it->first.substr(4, slash - 4);
+        std::string key = it->first.substr(slash + 1);
+        if (snapshot.interfaces.empty() || snapshot.interfaces.back().name != name) {
+            NetworkInterface iface = {};
+            iface.name = name;
+            snapshot.interfaces.push_back(iface);
+        }
+        NetworkInterface& iface = snapshot.interfaces.back();
+        if (key == "ipv4") {
+            iface.ipv4_address = it->second.text;
+            continue;
+        }
+        if (key == "group") {
+            iface.group = it->second.text;
+            continue;
+        }
+        if (key == "ipv6") {
+            iface.ipv6_address = it->second.text;
+            continue;
+        }
+        if (key == "speed") {
+            iface.link_speed_mbps = (int)it->second.number;
+            continue;
+        }
+        if (key == "ifindex") {
+            iface.ifindex = (int)it->second.number;
+            continue;
+        }
+        for (const auto& f : interface_fields) {
+            if (key == f.key) {
+                iface.*f.field = (unsigned long)it->second.number;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0;; i++) {
+        std::string prefix = "proc/" + std::to_string(i) + "/";
+        if (fields.find(prefix + "pid") == fields.end()) break;
+        ProcessInfo proc;
+        proc.pid = (int)number(prefix + "pid");
+        proc.name = text(prefix + "name");
+        proc.state = text(prefix + "state");
+        proc.cpu_usage = (float)number(prefix + "cpu");
+        proc.memory_usage = (float)number(prefix + "mem");
+        proc.memory_kb = (unsigned long)number(prefix + "rss");
+        proc.io_known = fields.find(prefix + "io_read") != fields.end();
+        proc.io_read_rate = (float)number(prefix + "io_read");
+        proc.io_write_rate = (float)number(prefix + "io_write");
+        proc.io_syscall_rate = (float)number(prefix + "io_calls");
+        snapshot.top_processes.push_back(proc);
+    }
+
+    return snapshot;
+}
+
+// Encoding helpers
+static void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += (char)((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += (char)value;
+}
+
+static void putFixed(std::string& out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out += (char)((value >> (8 * i)) & 0xff);
+    }
+}
+
+static void putString(std::string& out, const std::string& value) {
+    putVarint(out, value.size());
+    out += value;
+}
+
+static void putValue(std::string& out, uint32_t id, const FieldValue& value) {
+    if (value.is_string) {
+        out += (char)RECORD_STRING;
+        putVarint(out, id);
+        putString(out, value.text);
+    } else {
+        uint64_t bits;
+        memcpy(&bits, &value.number, sizeof(bits));
+        out += (char)RECORD_NUMBER;
+        putVarint(out, id);
+        putFixed(out, bits, 8);
+    }
+}
+
+static std::string beginFrame(uint8_t type, long long timestamp_ms) {
+    std::string frame(4, '\0');
+    frame += (char)type;
+    putFixed(frame, (uint64_t)timestamp_ms, 8);
+    return frame;
+}
+
+static void endFrame(std::string& frame) {
+    uint32_t length = frame.size() - 4;
+    for (int i = 0; i < 4; i++) {
+        frame[i] = (char)((length >> (8 * i)) & 0xff);
+    }
+}
+
+// Agent-side field table, diffed against each new sample
+struct StreamEncoder {
+    std::map<std::string, uint32_t> ids;
+    std::map<uint32_t, std::string> names;
+    std::map<uint32_t, FieldValue> values;
+    std::vector<uint32_t> free_ids;
+    uint32_t next_id = 0;
+};
+
+static std::string encodeDelta(StreamEncoder& encoder, const FieldList& fields, long long timestamp_ms) {
+    std::string frame = beginFrame(FRAME_DELTA, timestamp_ms);
+    std::map<std::string, bool> seen;
+
+    for (const auto& field : fields) {
+        seen[field.first] = true;
+        auto it = encoder.ids.find(field.first);
+        uint32_t id;
+        if (it == encoder.ids.end()) {
+            if (!encoder.free_ids.empty()) {
+                id = encoder.free_ids.back();
+                encoder.free_ids.pop_back();
+            } else {
+                id = encoder.next_id++;
+            }
+            encoder.ids[field.first] = id;
+            encoder.names[id] = field.first;
+            frame += (char)RECORD_DEFINE;
+            putVarint(frame, id);
+            putString(frame, field.first);
+        } else {
+            id = it->second;
+            auto value = encoder.values.find(id);
+            if (value != encoder.values.end() && value->second == field.second) continue;
+        }
+        encoder.values[id] = field.second;
+        putValue(frame, id, field.second);
+    }
+
+    // Fields that disappeared, e.g. an interface that went away
+    for (auto it = encoder.ids.begin(); it != encoder.ids.end();) {
+        if (seen.count(it->first)) {
+            ++it;
+            continue;
+        }
+        frame += (char)RECORD_REMOVE;
+        putVarint(frame, it->second);
+        encoder.values.erase(it->second);
+        encoder.names.erase(it->second);
+        encoder.free_ids.push_back(it->second);
+        it = encoder.ids.erase(it);
+    }
+
+    endFrame(frame);
+    return frame;
+}
+
+static std::string encodeKeyframe(const StreamEncoder& encoder, long long timestamp_ms) {
+    std::string frame = beginFrame(FRAME_DELTA, timestamp_ms);
+    for (const auto& entry : encoder.values) {
+        frame += (char)RECORD_DEFINE;
+        putVarint(frame, entry.first);
+        putString(frame, encoder.names.at(entry.first));
+        putValue(frame, entry.first, entry.second);
+    }
+    endFrame(frame);
+    return frame;
+}
+
+static std::string encodeHello() {
+    std::string frame = beginFrame(FRAME_HELLO, 0);
+    frame += (char)STREAM_VERSION;
+    endFrame(frame);
+    return frame;
+}
+
+// Decoding helpers; each returns false on a truncated or malformed frame
+struct FrameReader {
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+};
+
+static bool getVarint(FrameReader& reader, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (reader.pos >= reader.size) return false;
+        uint8_t byte = reader.data[reader.pos++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+static bool getFixed(FrameReader& reader, uint64_t& value, int bytes) {
+    if (reader.pos + bytes > reader.size) return false;
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint64_t)reader.data[reader.pos++] << (8 * i);
+    }
+    return true;
+}
+
+static bool getString(FrameReader& reader, std::string& value) {
+    uint64_t length;
+    if (!getVarint(reader, length) || length > reader.size - reader.pos) return false;
+    value.assign((const char*)reader.data + reader.pos, length);
+    reader.pos += length;
+    return true;
+}
+
+// Viewer-side field table
+struct StreamDecoder {
+    std::map<uint32_t, std::string> names;
+    std::map<std::string, FieldValue> fields;
+};
+
+static bool applyFrame(StreamDecoder& decoder, const uint8_t* data, size_t size) {
+    FrameReader reader = {data, size};
+    uint64_t type, timestamp;
+    if (!getFixed(reader, type, 1) || !getFixed(reader, timestamp, 8)) return false;
+
+    if (type == FRAME_HELLO) {
+        uint64_t version;
+        return getFixed(reader, version, 1) && version == STREAM_VERSION;
+    }
+    if (type != FRAME_DELTA) return false;
+
+    while (reader.pos < reader.size) {
+        uint8_t record = reader.data[reader.pos++];
+        uint64_t id;
+        if (!getVarint(reader, id)) return false;
+
+        if (record == RECORD_DEFINE) {
+            std::string name;
+            if (!getString(reader, name)) return false;
+            auto old = decoder.names.find(id);
+            if (old != decoder.names.end()) decoder.fields.erase(old->second);
+            decoder.names[id] = name;
+        } else if (record == RECORD_REMOVE) {
+            auto old = decoder.names.find(id);
+            if (old != decoder.names.end()) {
+                decoder.fields.erase(old->second);
+                decoder.names.erase(old);
+            }
+        } else if (record == RECORD_NUMBER || record == RECORD_STRING) {
+            FieldValue value;
+            if (record == RECORD_NUMBER) {
+                uint64_t bits;
+                if (!getFixed(reader, bits, 8)) return false;
+                memcpy(&value.number, &bits, sizeof(bits));
+            } else {
+                value.is_string = true;
+                if (!getString(reader, value.text)) return false;
+            }
+            auto name = decoder.names.find(id);
+            if (name == decoder.names.end()) return false;
+            decoder.fields[name->second] = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Resolve "unix:/path" or "host:port" into a socket address; passive for the
+// listening side, where an empty host means every address
+static bool resolveAddress(const std::string& address, bool passive, sockaddr_storage& storage, socklen_t& length,
+                           int& family) {
+    memset(&storage, 0, sizeof(storage));
+    if (address.compare(0, 5, "unix:") == 0) {
+        sockaddr_un* un = (sockaddr_un*)&storage;
+        std::string path = address.substr(5);
+        if (path.empty() || path.size() >= sizeof(un->sun_path)) return false;
+        un->sun_family = AF_UNIX;
+        memcpy(un->sun_path, path.c_str(), path.size() + 1);
+        length = sizeof(sockaddr_un);
+        family = AF_UNIX;
+        return true;
+    }
+
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos) return false;
+    std::string host = address.substr(0, colon);
+    std::string port = address.substr(colon + 1);
+    if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+        host = host.substr(1, host.size() - 2);
+    }
+
+    addrinfo hints = {};
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        return false;
+    }
+    memcpy(&storage, result->ai_addr, result->ai_addrlen);
+    length = result->ai_addrlen;
+    family = result->ai_family;
+    freeaddrinfo(result);
+    return true;
+}
+
+static long long nowMilliseconds() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------
+// Agent
+//----------------------------------------
+
+static std::atomic<bool> agent_running(false);
+static std::thread agent_thread;
+static int agent_listen_fd = -1;
+static int agent_wake_fd = -1;
+static std::string agent_unix_path;
+
+// Encoder state and frames waiting for the agent thread, guarded by agent_mutex
+static std::mutex agent_mutex;
+static StreamEncoder agent_encoder;
+static std::string agent_pending;
+
+struct AgentClient {
+    int fd;
+    std::string out;
+    size_t sent = 0;
+};
+
+// Called from the sampler thread: one encode per sample, shared by every viewer
+static void publishStreamFrame(const MetricsSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(agent_mutex);
+    agent_pending += encodeDelta(agent_encoder, flattenSnapshot(snapshot), snapshot.timestamp_ms);
+
+    uint64_t one = 1;
+    if (write(agent_wake_fd, &one, sizeof(one)) < 0) {
+        // The counter is already non-zero, the agent thread will wake anyway
+    }
+}
+
+// Returns false once the client should be dropped
+static bool flushClient(AgentClient& client) {
+    while (client.sent < client.out.size()) {
+        ssize_t n = send(client.fd, client.out.data() + client.sent, client.out.size() - client.sent, MSG_NOSIGNAL);
+        if (n < 0) return errno == EAGAIN || errno == EINTR;
+        client.sent += n;
+    }
+    client.out.clear();
+    client.sent = 0;
+    return true;
+}
+
+static void agentLoop() {
+    std::vector<AgentClient> clients;
+    std::vector<pollfd> fds;
+
+    while (agent_running) {
+        fds.clear();
+        fds.push_back({agent_listen_fd, POLLIN, 0});
+        fds.push_back({agent_wake_fd, POLLIN, 0});
+        for (const auto& client : clients) {
+            fds.push_back({client.fd, (short)(POLLIN | (client.out.empty() ? 0 : POLLOUT)), 0});
+        }
+
+        // Wake up periodically to notice shutdown
+        if (poll(fds.data(), fds.size(), 250) < 0 && errno != EINTR) break;
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            AgentClient& client = clients[i];
+            short revents = fds[i + 2].revents;
+            bool keep = !(revents & (POLLERR | POLLHUP | POLLNVAL));
+
+            // Viewers never send anything; reading only detects disconnects
+            if (keep && (revents & POLLIN)) {
+                char buf[256];
+                ssize_t n = recv(client.fd, buf, sizeof(buf), 0);
+                keep = n > 0 || (n < 0 && (errno == EAGAIN || errno == EINTR));
+            }
+            if (keep && client.out.size() > MAX_CLIENT_BACKLOG) keep = false;
+
+            if (!keep) {
+                close(client.fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+
+        if ((fds[0].revents | fds[1].revents) & POLLIN) {
+            uint64_t count;
+            if (read(agent_wake_fd, &count, sizeof(count)) < 0) {
+                // Nothing pending
+            }
+
+            // Hand out pending deltas before new viewers get a keyframe of the same state
+            std::lock_guard<std::mutex> lock(agent_mutex);
+            for (auto& client : clients) {
+                client.out += agent_pending;
+            }
+            agent_pending.clear();
+
+            int fd;
+            while ((fd = accept4(agent_listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                AgentClient client;
+                client.fd = fd;
+                client.out = encodeHello() + encodeKeyframe(agent_encoder, 0);
+                clients.push_back(client);
+            }
+        }
+
+        for (size_t i = clients.size(); i-- > 0;) {
+            if (!clients[i].out.empty() && !flushClient(clients[i])) {
+                close(clients[i].fd);
+                clients.erase(clients.begin() + i);
+            }
+        }
+    }
+
+    for (const auto& client : clients) {
+        close(client.fd);
+    }
+}
+
+bool startStreamAgent(const StreamSettings& settings) {
+    if (agent_running) return false;
+
+    sockaddr_storage addr;
+    socklen_t length;
+    int family;
+    if (!resolveAddress(settings.listen, true, addr, length, family)) return false;
+
+    int fd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return false;
+
+    if (family == AF_UNIX) {
+        agent_unix_path = ((sockaddr_un*)&addr)->sun_path;
+        unlink(agent_unix_path.c_str());
+    } else {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    }
+
+    if (bind(fd, (sockaddr*)&addr, length) != 0 || listen(fd, 64) != 0) {
+        close(fd);
+        return false;
+    }
+
+    agent_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (agent_wake_fd < 0) {
+        close(fd);
+        return false;
+    }
+
+    agent_listen_fd = fd;
+    agent_running = true;
+    addSnapshotListener(publishStreamFrame);
+    agent_thread = std::thread(agentLoop);
+    return true;
+}
+
+void stopStreamAgent() {
+    if (!agent_running) return;
+
+    agent_running = false;
+    if (agent_thread.joinable()) agent_thread.join();
+
+    close(agent_listen_fd);
+    close(agent_wake_fd);
+    agent_listen_fd = -1;
+    agent_wake_fd = -1;
+    if (!agent_unix_path.empty()) {
+        unlink(agent_unix_path.c_str());
+        agent_unix_path.clear();
+    }
+}
+
+//----------------------------------------
+// Viewer
+//----------------------------------------
+
+static std::atomic<bool> viewer_running(false);
+static std::thread viewer_thread;
+static std::mutex viewer_mutex;
+static std::vector<RemoteHost> viewer_hosts;
+
+// Agent names are resolved on a helper thread: getaddrinfo() blocks, and one
+// name timing out in DNS must not stall the epoll loop serving every other host.
+// Each address is resolved once and reused for every reconnect; a failed lookup
+// is tried again every RESOLVE_RETRY_MS.
+#define RESOLVE_RETRY_MS 5000
+
+struct ResolvedAddress {
+    bool done = false; // looked up at least once
+    bool ok = false;
+    sockaddr_storage addr;
+    socklen_t length = 0;
+    int family = 0;
+};
+
+// Shared with the detached resolver thread, which may still be inside
+// getaddrinfo() when the viewer stops
+struct ViewerResolver {
+    std::mutex mutex;
+    std::vector<ResolvedAddress> results;
+    std::atomic<bool> running{true};
+};
+
+static std::shared_ptr<ViewerResolver> viewer_resolver;
+
+static void resolverLoop(std::shared_ptr<ViewerResolver> resolver, std::vector<std::string> addresses) {
+    while (resolver->running) {
+        bool pending = false;
+        for (size_t i = 0; i < addresses.size() && resolver->running; i++) {
+            {
+                std::lock_guard<std::mutex> lock(resolver->mutex);
+                if (resolver->results[i].ok) continue;
+            }
+            ResolvedAddress result;
+            result.ok = resolveAddress(addresses[i], false, result.addr, result.length, result.family);
+            result.done = true;
+            pending |= !result.ok;
+            std::lock_guard<std::mutex> lock(resolver->mutex);
+            resolver->results[i] = result;
+        }
+        if (!pending) return;
+        for (int waited = 0; waited < RESOLVE_RETRY_MS && resolver->running; waited += 250) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        }
+    }
+}
+
+struct ViewerConnection {
+    std::string address;
+    int fd = -1;
+    bool connecting = false;
+    long long retry_at = 0;
+    std::string in;
+    StreamDecoder decoder;
+};
+
+static void setHostStatus(size_t index, bool connected, const std::string& status) {
+    {
+        std::lock_guard<std::mutex> lock(viewer_mutex);
+        viewer_hosts[index].connected = connected;
+        viewer_hosts[index].status = status;
+    }
+    requestRedraw();
+}
+
+static void closeViewerConnection(int epoll_fd, ViewerConnection& conn, size_t index, const std::string& status) {
+    if (conn.fd >= 0) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn.fd, nullptr);
+        close(conn.fd);
+    }
+    conn.fd = -1;
+    conn.connecting = false;
+    conn.in.clear();
+    conn.decoder = StreamDecoder();
+    conn.retry_at = nowMilliseconds() + 2000;
+    setHostStatus(index, false, status);
+}
+
+static void openViewerConnection(int epoll_fd, ViewerConnection& conn, size_t index) {
+    ResolvedAddress resolved;
+    {
+        std::lock_guard<std::mutex> lock(viewer_resolver->mutex);
+        resolved = viewer_resolver->results[index];
+    }
+    if (!resolved.done) {
+        conn.retry_at = nowMilliseconds() + 250; // still looking it up
+        return;
+    }
+    if (!resolved.ok) {
+        closeViewerConnection(epoll_fd, conn, index, "cannot resolve address");
+        return;
+    }
+    sockaddr_storage& addr = resolved.addr;
+    socklen_t length = resolved.length;
+
+    conn.fd = socket(resolved.family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (conn.fd < 0) {
+        closeViewerConnection(epoll_fd, conn, index, strerror(errno));
+        return;
+    }
+
+    int result = connect(conn.fd, (sockaddr*)&addr, length);
+    if (result != 0 && errno != EINPROGRESS) {
+        closeViewerConnection(epoll_fd, conn, index, strerror(errno));
+        return;
+    }
+
+    conn.connecting = result != 0;
+    epoll_event event = {};
+    event.events = EPOLLIN | EPOLLRDHUP | (conn.connecting ? (uint32_t)EPOLLOUT : 0u);
+    event.data.u64 = index;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, conn.fd, &event);
+    setHostStatus(index, !conn.connecting, conn.connecting ? "connecting" : "connected");
+}
+
+// The values a remote host keeps history for, as of one frame
+struct RemoteHistorySample {
+    float cpu_usage = 0.0f;
+    bool thermal_available = false;
+    float temperature = 0.0f;
+    bool fan_available = false;
+    float fan_speed = 0.0f;
+};
+
+static RemoteHistorySample remoteHistorySample(const std::map<std::string, FieldValue>& fields) {
+    auto number = [&](const std::string& key) {
+        auto it = fields.find(key);
+        return it != fields.end() ? it->second.number : 0.0;
+    };
+    RemoteHistorySample sample;
+    sample.cpu_usage = (float)number("cpu/usage");
+    sample.thermal_available = number("thermal/available") != 0.0;
+    sample.temperature = (float)number("thermal/temperature");
+    sample.fan_available = number("fan/available") != 0.0;
+    sample.fan_speed = (float)number("fan/speed");
+    return sample;
+}
+
+// Read everything available and apply each complete frame
+static void readViewerConnection(int epoll_fd, ViewerConnection& conn, size_t index) {
+    char buf[65536];
+    size_t received = 0;
+    for (;;) {
+        ssize_t n = recv(conn.fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            conn.in.append(buf, n);
+            received += n;
+            continue;
+        }
+        if (n == 0) {
+            closeViewerConnection(epoll_fd, conn, index, "agent closed the connection");
+            return;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN) break;
+        closeViewerConnection(epoll_fd, conn, index, strerror(errno));
+        return;
+    }
+
+    // A viewer that fell behind applies several frames at once; each still
+    // gets its history point
+    size_t offset = 0;
+    unsigned long frames = 0;
+    std::vector<RemoteHistorySample> samples;
+    while (conn.in.size() - offset >= 4) {
+        const uint8_t* p = (const uint8_t*)conn.in.data() + offset;
+        uint32_t length = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+        if (length > MAX_FRAME_SIZE) {
+            closeViewerConnection(epoll_fd, conn, index, "oversized frame");
+            return;
+        }
+        if (conn.in.size() - offset - 4 < length) break;
+        if (!applyFrame(conn.decoder, p + 4, length)) {
+            closeViewerConnection(epoll_fd, conn, index, "protocol error");
+            return;
+        }
+        offset += 4 + length;
+        frames++;
+        samples.push_back(remoteHistorySample(conn.decoder.fields));
+    }
+    conn.in.erase(0, offset);
+    if (frames == 0) return;
+
+    MetricsSnapshot snapshot = rebuildSnapshot(conn.decoder.fields);
+
+    {
+        std::lock_guard<std::mutex> lock(viewer_mutex);
+        RemoteHost& host = viewer_hosts[index];
+        // Interface rates come from the agent's own timestamps
+        if (host.has_snapshot) {
+            float seconds = (snapshot.timestamp_ms - host.snapshot.timestamp_ms) / 1000.0f;
+            updateInterfaceRates(host.snapshot.interfaces, snapshot.interfaces, seconds);
+        }
+        host.interface_groups = summarizeInterfaceGroups(snapshot.interfaces);
+        host.snapshot = snapshot;
+        host.has_snapshot = true;
+        host.frames_received += frames;
+        host.bytes_received += received;
+        for (const RemoteHistorySample& sample : samples) {
+            pushHistory(host.cpu_history, sample.cpu_usage);
+            if (sample.thermal_available) pushHistory(host.thermal_history, sample.temperature);
+            if (sample.fan_available) pushHistory(host.fan_history, sample.fan_speed);
+        }
+    }
+    requestRedraw();
+}
+
+static void viewerLoop(std::vector<std::string> addresses) {
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) return;
+
+    std::vector<ViewerConnection> connections(addresses.size());
+    for (size_t i = 0; i < addresses.size(); i++) {
+        connections[i].address = addresses[i];
+    }
+
+    std::vector<epoll_event> events(64);
+    while (viewer_running) {
+        long long now = nowMilliseconds();
+        for (size_t i = 0; i < connections.size(); i++) {
+            if (connections[i].fd < 0 && now >= connections[i].retry_at) {
+                openViewerConnection(epoll_fd, connections[i], i);
+            }
+        }
+
+        int count = epoll_wait(epoll_fd, events.data(), events.size(), 250);
+        for (int e = 0; e < count; e++) {
+            size_t index = events[e].data.u64;
+            ViewerConnection& conn = connections[index];
+            if (conn.fd < 0) continue;
+
+            if (conn.connecting && (events[e].events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+                int error = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(conn.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                if (error != 0) {
+                    closeViewerConnection(epoll_fd, conn, index, strerror(error));
+                    continue;
+                }
+                conn.connecting = false;
+                epoll_event event = {};
+                event.events = EPOLLIN | EPOLLRDHUP;
+                event.data.u64 = index;
+                epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+                setHostStatus(index, true, "connected");
+            }
+
+            if (!conn.connecting && (events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                readViewerConnection(epoll_fd, conn, index);
+            }
+        }
+    }
+
+    for (auto& conn : connections) {
+        if (conn.fd >= 0) close(conn.fd);
+    }
+    close(epoll_fd);
+}
+
+bool startStreamViewer(const std::vector<std::string>& addresses) {
+    if (viewer_running || addresses.empty()) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(viewer_mutex);
+        viewer_hosts.clear();
+        for (const auto& address : addresses) {
+            RemoteHost host;
+            host.address = address;
+            host.status = "connecting";
+            setHistoryCapacity(host.cpu_history, REMOTE_HISTORY_POINTS);
+            setHistoryCapacity(host.thermal_history, REMOTE_HISTORY_POINTS);
+            setHistoryCapacity(host.fan_history, REMOTE_HISTORY_POINTS);
+            viewer_hosts.push_back(host);
+        }
+    }
+
+    viewer_resolver = std::make_shared<ViewerResolver>();
+    viewer_resolver->results.resize(addresses.size());
+    std::thread(resolverLoop, viewer_resolver, addresses).detach();
+
+    viewer_running = true;
+    viewer_thread = std::thread(viewerLoop, addresses);
+    return true;
+}
+
+void stopStreamViewer() {
+    if (!viewer_running) return;
+
+    viewer_running = false;
+    if (viewer_thread.joinable()) viewer_thread.join();
+    viewer_resolver->running = false;
+    viewer_resolver.reset();
+}
+
+// Copies element by element so the caller's hosts keep their addresses and buffers
+void getRemoteHosts(std::vector<RemoteHost>& hosts) {
+    std::lock_guard<std::mutex> lock(viewer_mutex);
+    hosts.resize(viewer_hosts.size());
+    for (size_t i = 0; i < viewer_hosts.size(); i++) {
+        hosts[i] = viewer_hosts[i];
+    }
+}
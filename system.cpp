@@ -1,9 +1,59 @@
 #include "header.h"
+#include <cstring>
+#include <mutex>
+#include <sys/inotify.h>
 
-SystemInfo getSystemInfo() {
-    SystemInfo info;
+static HostFacts loadHostFacts() {
+    HostFacts facts;
+    
+    struct sysinfo sys;
+    if (sysinfo(&sys) == 0) {
+        facts.total_ram = (unsigned long)((unsigned long long)sys.totalram * sys.mem_unit / 1024);
+    }
+    
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0) facts.page_size = page_size;
     
+    long clock_ticks = sysconf(_SC_CLK_TCK);
+    if (clock_ticks > 0) facts.clock_ticks = clock_ticks;
+    
+    long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpu_count > 0) facts.cpu_count = (int)cpu_count;
+    
+    return facts;
+}
+
+const HostFacts& getHostFacts() {
+    static const HostFacts facts = loadHostFacts();
+    return facts;
+}
+
+SampleContext makeSampleContext() {
+    SampleContext context;
+    context.facts = &getHostFacts();
+    return context;
+}
+
+static void countProcessState(SystemInfo& info, char state) {
+    switch (state) {
+        case 'R': info.running_processes++; break;
+        case 'S': case 'D': info.sleeping_processes++; break;
+        case 'Z': info.zombie_processes++; break;
+        case 'T': case 't': info.stopped_processes++; break;
+    }
+}
+
+// Host identity (OS, user, hostname, CPU model) is read once and reloaded only
+// when inotify reports a change to /etc/hostname or /etc/os-release. /etc is
+// watched rather than the files, since both are usually replaced by rename.
+static std::mutex identity_mutex;
+static SystemInfo host_identity;
+static bool identity_loaded = false;
+static int identity_watch_fd = -1;
+
+static void loadHostIdentity(SystemInfo& info) {
     // Get OS type
+    info.os_type.clear();
     std::ifstream os_file("/etc/os-release");
     std::string line;
     while (std::getline(os_file, line)) {
@@ -46,14 +96,65 @@ SystemInfo getSystemInfo() {
             }
         }
     }
+}
+
+// Drains pending inotify events; true if any touched a file we read
+static bool identityChanged() {
+    if (identity_watch_fd < 0) return false;
+    
+    bool changed = false;
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(identity_watch_fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            if (event->len > 0 && (strcmp(event->name, "hostname") == 0 || strcmp(event->name, "os-release") == 0)) {
+                changed = true;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+static void copyHostIdentity(SystemInfo& info) {
+    std::lock_guard<std::mutex> lock(identity_mutex);
+    if (!identity_loaded) {
+        identity_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (identity_watch_fd >= 0) {
+            inotify_add_watch(identity_watch_fd, "/etc", IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+        }
+        loadHostIdentity(host_identity);
+        identity_loaded = true;
+    } else if (identityChanged()) {
+        loadHostIdentity(host_identity);
+    }
+    
+    info.os_type = host_identity.os_type;
+    info.username = host_identity.username;
+    info.hostname = host_identity.hostname;
+    info.cpu_type = host_identity.cpu_type;
+}
+
+SystemInfo getSystemInfo(const SampleContext& context) {
+    SystemInfo info;
+    copyHostIdentity(info);
     
-    // Get process counts
+    // Get process counts, from this tick's process scan when there is one
     info.total_processes = 0;
     info.running_processes = 0;
     info.sleeping_processes = 0;
     info.zombie_processes = 0;
     info.stopped_processes = 0;
     
+    if (context.processes) {
+        info.total_processes = context.processes->size();
+        for (const ProcessInfo& proc : *context.processes) {
+            if (!proc.state.empty()) countProcessState(info, proc.state[0]);
+        }
+        return info;
+    }
+    
     DIR* proc_dir = opendir("/proc");
     if (proc_dir) {
         struct dirent* entry;
@@ -82,13 +183,7 @@ SystemInfo getSystemInfo() {
                         iss >> token >> token;
                         // Get state
                         if (iss >> token) {
-                            char state = token[0];
-                            switch (state) {
-                                case 'R': info.running_processes++; break;
-                                case 'S': case 'D': info.sleeping_processes++; break;
-                                case 'Z': info.zombie_processes++; break;
-                                case 'T': case 't': info.stopped_processes++; break;
-                            }
+                            countProcessState(info, token[0]);
                         }
                     }
                 }
@@ -100,90 +195,49 @@ SystemInfo getSystemInfo() {
     return info;
 }
 
-CPUInfo getCPUInfo() {
-    static CPUInfo cpu_info;
-    static long prev_user = 0, prev_nice = 0, prev_system = 0, prev_idle = 0;
-    static long prev_iowait = 0, prev_irq = 0, prev_softirq = 0;
-    
+bool readCPUTimes(CPUInfo& info) {
     std::ifstream stat_file("/proc/stat");
     std::string line;
-    if (std::getline(stat_file, line)) {
-        std::istringstream iss(line);
-        std::string cpu_label;
-        iss >> cpu_label >> cpu_info.user >> cpu_info.nice >> cpu_info.system 
-            >> cpu_info.idle >> cpu_info.iowait >> cpu_info.irq >> cpu_info.softirq;
-        
-        long total_prev = prev_user + prev_nice + prev_system + prev_idle + prev_iowait + prev_irq + prev_softirq;
-        long total_curr = cpu_info.user + cpu_info.nice + cpu_info.system + cpu_info.idle + cpu_info.iowait + cpu_info.irq + cpu_info.softirq;
-        
-        long idle_prev = prev_idle + prev_iowait;
-        long idle_curr = cpu_info.idle + cpu_info.iowait;
-        
-        long total_diff = total_curr - total_prev;
-        long idle_diff = idle_curr - idle_prev;
-        
-        if (total_diff > 0) {
-            cpu_info.usage_percent = 100.0f * (total_diff - idle_diff) / total_diff;
-        } else {
-            cpu_info.usage_percent = 0.0f;
-        }
-        
-        prev_user = cpu_info.user;
-        prev_nice = cpu_info.nice;
-        prev_system = cpu_info.system;
-        prev_idle = cpu_info.idle;
-        prev_iowait = cpu_info.iowait;
-        prev_irq = cpu_info.irq;
-        prev_softirq = cpu_info.softirq;
-    }
+    if (!std::getline(stat_file, line)) return false;
     
-    return cpu_info;
+    std::istringstream iss(line);
+    std::string cpu_label;
+    return (bool)(iss >> cpu_label >> info.user >> info.nice >> info.system 
+                      >> info.idle >> info.iowait >> info.irq >> info.softirq);
 }
 
-ThermalInfo getThermalInfo() {
-    static ThermalInfo thermal_info;
-    
-    // Try to read temperature from thermal zone
-    std::ifstream temp_file("/sys/class/thermal/thermal_zone0/temp");
-    if (temp_file.is_open()) {
-        int temp_millidegrees;
-        if (temp_file >> temp_millidegrees) {
-            thermal_info.temperature = temp_millidegrees / 1000.0f;
-        }
-    } else {
-        // Fallback to a simulated temperature
-        thermal_info.temperature = 45.0f + (rand() % 20); // 45-65°C
-    }
+float cpuUsageBetween(const CPUInfo& prev, const CPUInfo& curr) {
+    long total_prev = prev.user + prev.nice + prev.system + prev.idle + prev.iowait + prev.irq + prev.softirq;
+    long total_curr = curr.user + curr.nice + curr.system + curr.idle + curr.iowait + curr.irq + curr.softirq;
+    
+    long idle_prev = prev.idle + prev.iowait;
+    long idle_curr = curr.idle + curr.iowait;
     
-    return thermal_info;
+    long total_diff = total_curr - total_prev;
+    long idle_diff = idle_curr - idle_prev;
+    
+    if (total_diff > 0) {
+        return 100.0f * (total_diff - idle_diff) / total_diff;
+    }
+    return 0.0f;
 }
 
-FanInfo getFanInfo() {
-    static FanInfo fan_info;
-    
-    // Try to read fan information from hwmon
-    bool found_fan = false;
-    for (int i = 0; i < 10; i++) {
-        std::string fan_input_path = "/sys/class/hwmon/hwmon" + std::to_string(i) + "/fan1_input";
-        std::ifstream fan_file(fan_input_path);
-        if (fan_file.is_open()) {
-            if (fan_file >> fan_info.speed) {
-                fan_info.active = fan_info.speed > 0;
-                fan_info.level = fan_info.speed / 1000; // Approximate level
-                found_fan = true;
-                break;
-            }
-        }
-    }
+CPUInfo getCPUInfo() {
+    static CPUInfo cpu_info;
+    static CPUInfo prev_info;
     
-    if (!found_fan) {
-        // Simulate fan data
-        fan_info.active = true;
-        fan_info.speed = 2000 + (rand() % 1000); // 2000-3000 RPM
-        fan_info.level = fan_info.speed / 1000;
+    if (readCPUTimes(cpu_info)) {
+        cpu_info.usage_percent = cpuUsageBetween(prev_info, cpu_info);
+        prev_info.user = cpu_info.user;
+        prev_info.nice = cpu_info.nice;
+        prev_info.system = cpu_info.system;
+        prev_info.idle = cpu_info.idle;
+        prev_info.iowait = cpu_info.iowait;
+        prev_info.irq = cpu_info.irq;
+        prev_info.softirq = cpu_info.softirq;
     }
     
-    return fan_info;
+    return cpu_info;
 }
 
 std::string trim(const std::string& str) {
@@ -192,10 +246,3 @@ std::string trim(const std::string& str) {
     size_t last = str.find_last_not_of(' ');
     return str.substr(first, (last - first + 1));
 }
-
-void updateGraphData(std::deque<float>& data, float value, int max_points) {
-    data.push_back(value);
-    while (data.size() > float(max_points)) {
-        data.pop_front();
-    }
-}
\ No newline at end of file
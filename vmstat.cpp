@@ -0,0 +1,89 @@
+#include "header.h"
+#include <cstring>
+#include <fcntl.h>
+
+// Counters we keep from /proc/vmstat. Older kernels split some of them per zone
+// (allocstall_normal, pgscan_kswapd_dma32, ...); those are summed into one field.
+static const struct {
+    const char* key;
+    unsigned long VmStatInfo::* counter;
+    float VmStatRates::* rate;
+} vmstat_fields[] = {
+    {"pgfault", &VmStatInfo::pgfault, &VmStatRates::pgfault},
+    {"pgmajfault", &VmStatInfo::pgmajfault, &VmStatRates::pgmajfault},
+    {"pswpin", &VmStatInfo::pswpin, &VmStatRates::pswpin},
+    {"pswpout", &VmStatInfo::pswpout, &VmStatRates::pswpout},
+    {"pgscan_kswapd", &VmStatInfo::pgscan_kswapd, &VmStatRates::pgscan_kswapd},
+    {"pgscan_direct", &VmStatInfo::pgscan_direct, &VmStatRates::pgscan_direct},
+    {"pgsteal_kswapd", &VmStatInfo::pgsteal_kswapd, &VmStatRates::pgsteal_kswapd},
+    {"pgsteal_direct", &VmStatInfo::pgsteal_direct, &VmStatRates::pgsteal_direct},
+    {"allocstall", &VmStatInfo::allocstall, &VmStatRates::allocstall},
+    {"compact_stall", &VmStatInfo::compact_stall, &VmStatRates::compact_stall},
+    {"thp_fault_alloc", &VmStatInfo::thp_fault_alloc, &VmStatRates::thp_fault_alloc},
+    {"thp_fault_fallback", &VmStatInfo::thp_fault_fallback, &VmStatRates::thp_fault_fallback},
+    {"thp_collapse_alloc", &VmStatInfo::thp_collapse_alloc, &VmStatRates::thp_collapse_alloc},
+    {"thp_split_page", &VmStatInfo::thp_split_page, &VmStatRates::thp_split_page},
+    {"oom_kill", &VmStatInfo::oom_kill, &VmStatRates::oom_kill},
+};
+
+static const char* vmstat_zones[] = {"dma", "dma32", "normal", "movable", "high"};
+
+// Length of the key once a per-zone suffix is removed
+static size_t stripZone(const char* key, size_t length) {
+    for (const char* zone : vmstat_zones) {
+        size_t zone_length = strlen(zone);
+        if (length > zone_length + 1 && key[length - zone_length - 1] == '_' &&
+            strncmp(key + length - zone_length, zone, zone_length) == 0) {
+            return length - zone_length - 1;
+        }
+    }
+    return length;
+}
+
+bool readVmStat(VmStatInfo& info) {
+    info = VmStatInfo();
+
+    int fd = open("/proc/vmstat", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    char buffer[16384];
+    size_t length = 0;
+    ssize_t n;
+    while (length < sizeof(buffer) - 1 && (n = read(fd, buffer + length, sizeof(buffer) - 1 - length)) > 0) {
+        length += n;
+    }
+    close(fd);
+    if (length == 0) return false;
+    buffer[length] = '\0';
+
+    // Lines look like "pgmajfault 12345"
+    for (char* line = buffer; *line; ) {
+        char* space = strchr(line, ' ');
+        char* end = strchr(line, '\n');
+        if (!end) end = buffer + length;
+        if (space && space < end) {
+            size_t key_length = stripZone(line, space - line);
+            for (const auto& f : vmstat_fields) {
+                if (strncmp(f.key, line, key_length) == 0 && f.key[key_length] == '\0') {
+                    info.*f.counter += strtoul(space + 1, nullptr, 10);
+                    break;
+                }
+            }
+        }
+        line = *end ? end + 1 : end;
+    }
+    return true;
+}
+
+VmStatRates vmStatRatesBetween(const VmStatInfo& prev, const VmStatInfo& curr, float seconds) {
+    VmStatRates rates;
+    if (seconds <= 0.0f) return rates;
+
+    for (const auto& f : vmstat_fields) {
+        // A counter going backwards means it was reset; report no activity
+        unsigned long before = prev.*f.counter;
+        unsigned long after = curr.*f.counter;
+        rates.*f.rate = after >= before ? (after - before) / seconds : 0.0f;
+    }
+    return rates;
+}